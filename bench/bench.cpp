@@ -0,0 +1,378 @@
+// Logic benchmark suite (no SDL).
+//
+// Times game, scene and controller hot paths and reports, per benchmark:
+// ns/op (median of the repetitions, plus min/mean/stddev), ops/sec and heap
+// allocations (+ bytes) per op. Each benchmark first runs for the warmup time,
+// which also sizes the batch so one repetition lasts about --min-time / reps.
+//
+// Usage: tiletwister_bench [--filter SUBSTR] [--reps N] [--min-time MS]
+//                          [--warmup MS] [--json FILE] [--list]
+//   --json FILE  also write the results as JSON (for comparing runs)
+
+#include <tiletwister/core/AllocHooks.hpp>
+#include <tiletwister/core/Rng.hpp>
+#include <tiletwister/core/Utils.hpp>
+#include <tiletwister/engine/Scene.hpp>
+#include <tiletwister/game/Game.hpp>
+#include <tiletwister/game/TileStore.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+// Keeps results observable so the optimizer can't drop the work.
+volatile std::uint64_t g_sink = 0;
+
+using Clock = std::chrono::steady_clock;
+
+// A benchmark runs its operation `ops` times per call.
+struct Benchmark {
+  std::string name;
+  std::function<void(std::uint64_t ops)> run;
+};
+
+struct Result {
+  std::string name;
+  int reps = 0;
+  std::uint64_t opsPerRep = 0;
+  double nsMedian = 0.0;
+  double nsMin = 0.0;
+  double nsMean = 0.0;
+  double nsStddev = 0.0;
+  double allocsPerOp = 0.0;
+  double bytesPerOp = 0.0;
+};
+
+struct Options {
+  std::string filter;
+  int reps = 5;
+  double minTimeMs = 500.0;
+  double warmupMs = 100.0;
+  std::string jsonPath;
+  bool list = false;
+};
+
+double elapsedNs(Clock::time_point a, Clock::time_point b) {
+  return std::chrono::duration<double, std::nano>(b - a).count();
+}
+
+Result measure(const Benchmark& b, const Options& opt) {
+  // Warmup: grow the batch until it takes a measurable time, keep running
+  // until the warmup budget is spent; the last batch rate sizes the reps.
+  std::uint64_t batch = 1;
+  double nsPerOp = 0.0;
+  const auto warmStart = Clock::now();
+  for (;;) {
+    const auto t0 = Clock::now();
+    b.run(batch);
+    const auto t1 = Clock::now();
+    const double ns = elapsedNs(t0, t1);
+    nsPerOp = ns / static_cast<double>(batch);
+    if (elapsedNs(warmStart, t1) >= opt.warmupMs * 1e6) break;
+    if (ns < 1e6) batch *= 2;
+  }
+
+  const double repNs = opt.minTimeMs * 1e6 / opt.reps;
+  const std::uint64_t ops = std::max<std::uint64_t>(
+      1, static_cast<std::uint64_t>(repNs / std::max(nsPerOp, 0.1)));
+
+  Result r;
+  r.name = b.name;
+  r.reps = opt.reps;
+  r.opsPerRep = ops;
+  std::vector<double> samples;
+  std::uint64_t allocs = 0;
+  std::uint64_t bytes = 0;
+  for (int i = 0; i < opt.reps; ++i) {
+    const AllocScope scope;
+    const auto t0 = Clock::now();
+    b.run(ops);
+    const auto t1 = Clock::now();
+    allocs += scope.allocations();
+    bytes += scope.bytes();
+    samples.push_back(elapsedNs(t0, t1) / static_cast<double>(ops));
+  }
+
+  std::sort(samples.begin(), samples.end());
+  const std::size_t n = samples.size();
+  r.nsMedian = n % 2 ? samples[n / 2]
+                     : 0.5 * (samples[n / 2 - 1] + samples[n / 2]);
+  r.nsMin = samples.front();
+  double sum = 0.0;
+  for (double s : samples) sum += s;
+  r.nsMean = sum / static_cast<double>(n);
+  double var = 0.0;
+  for (double s : samples) var += (s - r.nsMean) * (s - r.nsMean);
+  r.nsStddev = n > 1 ? std::sqrt(var / static_cast<double>(n - 1)) : 0.0;
+  const double totalOps = static_cast<double>(ops) * opt.reps;
+  r.allocsPerOp = static_cast<double>(allocs) / totalOps;
+  r.bytesPerOp = static_cast<double>(bytes) / totalOps;
+  return r;
+}
+
+// ---- Fixtures ----
+
+// A mid-game position reached by random play from a fixed seed, with no spawn
+// pending, so every op starts from the same board.
+GameState midGameState(std::uint64_t seed, int moves) {
+  Game g(seed);
+  Rng rng(seed ^ 0x9E3779B97F4A7C15ull);
+  for (int i = 0; i < moves && !g.isGameOver(); ++i) {
+    g.tryMove(static_cast<Direction>(rng.below(4)));
+    g.commitPendingSpawn();
+  }
+  g.commitPendingSpawn();
+  return g.state();
+}
+
+// A board where the given direction is guaranteed to move something.
+GameState movableState(Direction dir) {
+  for (std::uint64_t seed = 1;; ++seed) {
+    const GameState st = midGameState(seed, 60);
+    Game g(seed);
+    g.restore(st);
+    if (g.tryMove(dir).moved) return st;
+  }
+}
+
+const char* directionName(Direction d) {
+  switch (d) {
+  case Direction::Left:
+    return "left";
+  case Direction::Right:
+    return "right";
+  case Direction::Up:
+    return "up";
+  case Direction::Down:
+    return "down";
+  }
+  return "?";
+}
+
+struct CountingObject final : public GameObject {
+  std::uint64_t ticks = 0;
+  int z;
+  explicit CountingObject(int zIndex) : z(zIndex) {}
+  void update(float) override { ++ticks; }
+  void render(SDL_Renderer*) override { g_sink = g_sink + ticks; }
+  int zIndex() const override { return z; }
+};
+
+std::vector<Benchmark> makeBenchmarks() {
+  std::vector<Benchmark> list;
+
+  // Game::tryMove per direction (restore + move; restore is a plain copy).
+  for (Direction dir : {Direction::Left, Direction::Right, Direction::Up,
+                        Direction::Down}) {
+    const GameState st = movableState(dir);
+    list.push_back({std::string("game.tryMove.") + directionName(dir),
+                    [st, dir](std::uint64_t ops) {
+                      Game g(1);
+                      for (std::uint64_t i = 0; i < ops; ++i) {
+                        g.restore(st);
+                        g_sink = g_sink + g.tryMove(dir).animations.size();
+                      }
+                    }});
+  }
+
+  // Move + spawn: includes rollSpawn (empty-cell scan + RNG) and the commit.
+  {
+    const GameState st = movableState(Direction::Left);
+    list.push_back({"game.moveAndSpawn", [st](std::uint64_t ops) {
+                      Game g(1);
+                      for (std::uint64_t i = 0; i < ops; ++i) {
+                        g.restore(st);
+                        g.tryMove(Direction::Left);
+                        g_sink = g_sink + g.commitPendingSpawn();
+                      }
+                    }});
+  }
+
+  {
+    const GameState st = midGameState(7, 40);
+    list.push_back({"utils.emptyCells", [st](std::uint64_t ops) {
+                      for (std::uint64_t i = 0; i < ops; ++i)
+                        g_sink = g_sink + Utils::emptyCells(st.grid).size();
+                    }});
+  }
+
+  // isGameOver: a mid-game board (early out) and a full, stuck board (worst
+  // case: every neighbor pair checked).
+  {
+    const GameState mid = midGameState(3, 40);
+    list.push_back({"game.isGameOver.mid", [mid](std::uint64_t ops) {
+                      Game g(1);
+                      g.restore(mid);
+                      for (std::uint64_t i = 0; i < ops; ++i)
+                        g_sink = g_sink + g.isGameOver();
+                    }});
+    const int stuck[4][4] = {
+        {2, 4, 2, 4}, {4, 2, 4, 2}, {2, 4, 2, 4}, {4, 2, 4, 2}};
+    list.push_back({"game.isGameOver.stuck", [stuck](std::uint64_t ops) {
+                      Game g(1);
+                      g.setGridForTest(stuck);
+                      g.clearPendingSpawnForTest();
+                      for (std::uint64_t i = 0; i < ops; ++i)
+                        g_sink = g_sink + g.isGameOver();
+                    }});
+  }
+
+  // Whole random games, start to game over (one op = one game).
+  list.push_back({"game.randomGame", [](std::uint64_t ops) {
+                    static std::uint64_t seed = 1;
+                    for (std::uint64_t i = 0; i < ops; ++i) {
+                      Game g(seed++);
+                      Rng rng(seed);
+                      while (!g.isGameOver()) {
+                        g.tryMove(static_cast<Direction>(rng.below(4)));
+                        g.commitPendingSpawn();
+                      }
+                      g_sink = g_sink + g.score();
+                    }
+                  }});
+
+  // Scene: update + render of 1000 pooled objects (render order cached).
+  for (int count : {1000, 10000}) {
+    auto scene = std::make_shared<Scene>();
+    for (int i = 0; i < count; ++i) scene->spawn<CountingObject>(i % 7);
+    list.push_back({"scene.update." + std::to_string(count),
+                    [scene](std::uint64_t ops) {
+                      for (std::uint64_t i = 0; i < ops; ++i)
+                        scene->update(1.0f / 120.0f);
+                    }});
+    list.push_back({"scene.render." + std::to_string(count),
+                    [scene](std::uint64_t ops) {
+                      for (std::uint64_t i = 0; i < ops; ++i)
+                        scene->render(nullptr);
+                    }});
+  }
+
+  // Controller paths (GameSimulation): rebuilding the visual tiles from the
+  // grid, and one full move cycle (beginMove .. finishActiveMove).
+  {
+    const GameState st = movableState(Direction::Left);
+    list.push_back({"controller.rebuildTilesFromGrid",
+                    [st](std::uint64_t ops) {
+                      TileStore tiles;
+                      for (std::uint64_t i = 0; i < ops; ++i) {
+                        tiles.syncFromGrid(st.grid);
+                        g_sink = g_sink + tiles.size();
+                      }
+                    }});
+    list.push_back({"controller.moveCycle", [st](std::uint64_t ops) {
+                      Game g(1);
+                      TileStore tiles;
+                      for (std::uint64_t i = 0; i < ops; ++i) {
+                        g.restore(st);
+                        tiles.syncFromGrid(g.grid());
+                        const MoveResult mr = g.tryMove(Direction::Left);
+                        tiles.beginMove(mr, 0.12f);
+                        tiles.update(0.06f);
+                        g.commitPendingSpawn();
+                        tiles.finishMove(g.grid());
+                        g_sink = g_sink + tiles.size();
+                      }
+                    }});
+  }
+
+  return list;
+}
+
+void writeJson(const std::string& path, const Options& opt,
+               const std::vector<Result>& results) {
+  std::FILE* f = std::fopen(path.c_str(), "w");
+  if (!f) {
+    std::fprintf(stderr, "cannot write %s\n", path.c_str());
+    return;
+  }
+#ifdef NDEBUG
+  const char* build = "release";
+#else
+  const char* build = "debug";
+#endif
+  std::fprintf(f, "{\n  \"suite\": \"tiletwister_bench\",\n");
+  std::fprintf(f, "  \"format\": 1,\n");
+  std::fprintf(f, "  \"timestamp\": %lld,\n",
+               static_cast<long long>(std::time(nullptr)));
+  std::fprintf(f, "  \"build\": \"%s\",\n", build);
+  std::fprintf(f,
+               "  \"config\": {\"reps\": %d, \"min_time_ms\": %.1f, "
+               "\"warmup_ms\": %.1f},\n",
+               opt.reps, opt.minTimeMs, opt.warmupMs);
+  std::fprintf(f, "  \"results\": [\n");
+  for (std::size_t i = 0; i < results.size(); ++i) {
+    const Result& r = results[i];
+    std::fprintf(f,
+                 "    {\"name\": \"%s\", \"reps\": %d, \"ops_per_rep\": %llu, "
+                 "\"ns_per_op\": %.3f, \"ns_per_op_min\": %.3f, "
+                 "\"ns_per_op_mean\": %.3f, \"ns_per_op_stddev\": %.3f, "
+                 "\"ops_per_sec\": %.1f, \"allocs_per_op\": %.4f, "
+                 "\"bytes_per_op\": %.2f}%s\n",
+                 r.name.c_str(), r.reps,
+                 static_cast<unsigned long long>(r.opsPerRep), r.nsMedian,
+                 r.nsMin, r.nsMean, r.nsStddev, 1e9 / r.nsMedian,
+                 r.allocsPerOp, r.bytesPerOp,
+                 i + 1 < results.size() ? "," : "");
+  }
+  std::fprintf(f, "  ]\n}\n");
+  std::fclose(f);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  Options opt;
+  for (int i = 1; i < argc; ++i) {
+    const bool hasValue = i + 1 < argc;
+    if (std::strcmp(argv[i], "--filter") == 0 && hasValue) {
+      opt.filter = argv[++i];
+    } else if (std::strcmp(argv[i], "--reps") == 0 && hasValue) {
+      opt.reps = std::max(1, std::atoi(argv[++i]));
+    } else if (std::strcmp(argv[i], "--min-time") == 0 && hasValue) {
+      opt.minTimeMs = std::max(1.0, std::atof(argv[++i]));
+    } else if (std::strcmp(argv[i], "--warmup") == 0 && hasValue) {
+      opt.warmupMs = std::max(0.0, std::atof(argv[++i]));
+    } else if (std::strcmp(argv[i], "--json") == 0 && hasValue) {
+      opt.jsonPath = argv[++i];
+    } else if (std::strcmp(argv[i], "--list") == 0) {
+      opt.list = true;
+    } else {
+      std::fprintf(stderr, "unknown option %s\n", argv[i]);
+      return 1;
+    }
+  }
+
+  const std::vector<Benchmark> benchmarks = makeBenchmarks();
+  std::vector<Result> results;
+
+  if (!opt.list)
+    std::printf("%-34s %12s %12s %14s %10s\n", "benchmark", "ns/op",
+                "+-stddev", "ops/sec", "allocs/op");
+  for (const Benchmark& b : benchmarks) {
+    if (!opt.filter.empty() && b.name.find(opt.filter) == std::string::npos)
+      continue;
+    if (opt.list) {
+      std::printf("%s\n", b.name.c_str());
+      continue;
+    }
+    const Result r = measure(b, opt);
+    std::printf("%-34s %12.1f %12.1f %14.0f %10.2f\n", r.name.c_str(),
+                r.nsMedian, r.nsStddev, 1e9 / r.nsMedian, r.allocsPerOp);
+    std::fflush(stdout);
+    results.push_back(r);
+  }
+
+  if (!opt.jsonPath.empty()) writeJson(opt.jsonPath, opt, results);
+  return 0;
+}
@@ -0,0 +1,222 @@
+// Headless rendering benchmark (no display needed).
+//
+// Renders typical and worst-case boards, and walls of 64 and 256 boards,
+// through Renderer into an offscreen software surface and reports frames/sec,
+// draw calls and heap allocations per frame (steady state should be 0).
+//
+// Usage: tiletwister_render_bench [--frames N] [--dump DIR] [--compare DIR]
+//                                 [--tolerance T]
+//   --dump DIR     write the first frame of each scenario to DIR/<name>.bmp
+//   --compare DIR  compare the first frame against DIR/<name>.bmp; exit code 2
+//                  if any pixel differs by more than T (default 0)
+
+#include <tiletwister/core/AllocHooks.hpp>
+#include <tiletwister/game/GameWall.hpp>
+#include <tiletwister/game/MovePolicy.hpp>
+#include <tiletwister/game/RenderSnapshot.hpp>
+#include <tiletwister/game/TileStore.hpp>
+#include <tiletwister/platform/OffscreenTarget.hpp>
+#include <tiletwister/render/Renderer.hpp>
+
+#include <SDL2/SDL.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+
+namespace {
+
+struct Scenario {
+  const char* name;
+  int grid[4][4];
+  bool animate;  // keep every tile sliding + popping
+  bool gameOver; // draw the game-over overlay on top
+};
+
+// Animated scenarios also bump the score every frame (HUD redraw path).
+
+const Scenario kScenarios[] = {
+    {"typical",
+     {{2, 0, 4, 0}, {0, 8, 0, 2}, {16, 0, 32, 0}, {0, 4, 0, 64}},
+     false,
+     false},
+    {"typical_sliding",
+     {{2, 0, 4, 0}, {0, 8, 0, 2}, {16, 0, 32, 0}, {0, 4, 0, 64}},
+     true,
+     false},
+    {"worst_case",
+     {{1024, 2048, 4096, 8192},
+      {16384, 32768, 65536, 131072},
+      {1024, 2048, 4096, 8192},
+      {16384, 32768, 65536, 131072}},
+     true,
+     true},
+};
+
+// Wall scenarios: boards of deterministic corner-policy games, each stopped
+// after a different number of moves so every tile size shows up.
+const int kWallSizes[] = {64, 256};
+
+void fillWall(WallSnapshot& wall, int boards) {
+  CornerPolicy policy;
+  wall.boardCount = boards;
+  for (int i = 0; i < boards; ++i) {
+    Game game(static_cast<std::uint64_t>(i) + 1);
+    game.commitPendingSpawn();
+    for (int m = 0; m < 20 + 7 * i && !game.isGameOver(); ++m) {
+      Direction dir;
+      if (!policy.chooseMove(game.grid(), dir)) break;
+      game.tryMove(dir);
+      game.commitPendingSpawn();
+    }
+    wall.boards[i] = Bitboards::fromGrid(game.grid());
+  }
+}
+
+void restartAnimations(TileStore& tiles) {
+  for (int i = 0; i < tiles.size(); ++i) {
+    const int id = tiles.idAt(i);
+    if (tiles.isSliding(id) || tiles.isPopping(id)) continue;
+    const Cell to = tiles.tile(id).cell();
+    const Cell from{to.r, (to.c + 3) % 4};
+    tiles.startSlide(id, from, to, 0.12f);
+    tiles.startPop(id, 0.10f);
+  }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  int frames = 2000;
+  int tolerance = 0;
+  std::string dumpDir;
+  std::string compareDir;
+  for (int i = 1; i < argc; ++i) {
+    const bool hasValue = i + 1 < argc;
+    if (std::strcmp(argv[i], "--frames") == 0 && hasValue) {
+      frames = std::max(1, std::atoi(argv[++i]));
+    } else if (std::strcmp(argv[i], "--dump") == 0 && hasValue) {
+      dumpDir = argv[++i];
+    } else if (std::strcmp(argv[i], "--compare") == 0 && hasValue) {
+      compareDir = argv[++i];
+    } else if (std::strcmp(argv[i], "--tolerance") == 0 && hasValue) {
+      tolerance = std::atoi(argv[++i]);
+    } else {
+      std::fprintf(stderr,
+                   "usage: %s [--frames N] [--dump DIR] [--compare DIR] "
+                   "[--tolerance T]\n",
+                   argv[0]);
+      return 1;
+    }
+  }
+
+  const int w = 600;
+  const int h = 600;
+  OffscreenTarget target;
+  if (!target.init(w, h)) {
+    std::fprintf(stderr, "offscreen init failed: %s\n", SDL_GetError());
+    return 1;
+  }
+
+  bool mismatch = false;
+  const float dt = 1.0f / 60.0f;
+
+  std::printf("%-16s %10s %10s %12s %8s %8s\n", "scenario", "frames", "fps",
+              "ms/frame", "draws", "allocs");
+  for (const Scenario& s : kScenarios) {
+    Renderer renderer;
+    TileStore tiles;
+    tiles.syncFromGrid(s.grid);
+    RenderSnapshot frame;
+    frame.score = 12345;
+    frame.bestScore = 67890;
+    frame.gameOver = s.gameOver;
+    captureTiles(tiles, frame);
+
+    // First frame: deterministic (no animation yet) -> golden image.
+    renderer.render(target.renderer(), frame, 1.0f, w, h, false);
+    const std::string file = std::string(s.name) + ".bmp";
+    if (!dumpDir.empty() && !target.saveBMP(dumpDir + "/" + file)) {
+      std::fprintf(stderr, "failed to write %s/%s\n", dumpDir.c_str(),
+                   file.c_str());
+    }
+    if (!compareDir.empty()) {
+      const int diff =
+          target.countDifferingPixels(compareDir + "/" + file, tolerance);
+      if (diff != 0) {
+        std::fprintf(stderr, "%s: %d differing pixels vs %s/%s\n", s.name,
+                     diff, compareDir.c_str(), file.c_str());
+        mismatch = true;
+      }
+    }
+
+    long long drawCalls = 0;
+    const AllocScope allocs;
+    const auto t0 = std::chrono::steady_clock::now();
+    for (int f = 0; f < frames; ++f) {
+      if (s.animate) {
+        restartAnimations(tiles);
+        tiles.update(dt);
+        captureTiles(tiles, frame);
+        frame.score = 12345 + f;
+      }
+      renderer.render(target.renderer(), frame, 0.5f, w, h, false);
+      drawCalls += renderer.lastFrameStats().drawCalls;
+    }
+    const auto t1 = std::chrono::steady_clock::now();
+    const double allocsPerFrame =
+        static_cast<double>(allocs.allocations()) / frames;
+
+    const double sec = std::chrono::duration<double>(t1 - t0).count();
+    std::printf("%-16s %10d %10.1f %12.4f %8.1f %8.2f\n", s.name, frames,
+                frames / sec, 1000.0 * sec / frames,
+                static_cast<double>(drawCalls) / frames, allocsPerFrame);
+  }
+
+  // Walls: same golden-image and timing treatment; renderWall reads the
+  // packed boards directly.
+  auto wall = std::make_unique<WallSnapshot>();
+  for (const int boards : kWallSizes) {
+    fillWall(*wall, boards);
+    Renderer renderer;
+    const std::string name = "wall_" + std::to_string(boards);
+    renderer.renderWall(target.renderer(), *wall, w, h);
+    const std::string file = name + ".bmp";
+    if (!dumpDir.empty() && !target.saveBMP(dumpDir + "/" + file)) {
+      std::fprintf(stderr, "failed to write %s/%s\n", dumpDir.c_str(),
+                   file.c_str());
+    }
+    if (!compareDir.empty()) {
+      const int diff =
+          target.countDifferingPixels(compareDir + "/" + file, tolerance);
+      if (diff != 0) {
+        std::fprintf(stderr, "%s: %d differing pixels vs %s/%s\n",
+                     name.c_str(), diff, compareDir.c_str(), file.c_str());
+        mismatch = true;
+      }
+    }
+
+    long long drawCalls = 0;
+    const AllocScope allocs;
+    const auto t0 = std::chrono::steady_clock::now();
+    for (int f = 0; f < frames; ++f) {
+      renderer.renderWall(target.renderer(), *wall, w, h);
+      drawCalls += renderer.lastFrameStats().drawCalls;
+    }
+    const auto t1 = std::chrono::steady_clock::now();
+    const double allocsPerFrame =
+        static_cast<double>(allocs.allocations()) / frames;
+
+    const double sec = std::chrono::duration<double>(t1 - t0).count();
+    std::printf("%-16s %10d %10.1f %12.4f %8.1f %8.2f\n", name.c_str(),
+                frames, frames / sec, 1000.0 * sec / frames,
+                static_cast<double>(drawCalls) / frames, allocsPerFrame);
+  }
+
+  target.shutdown();
+  return mismatch ? 2 : 0;
+}
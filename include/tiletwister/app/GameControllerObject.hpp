@@ -1,20 +1,22 @@
 #pragma once
 
+#include <tiletwister/app/GameSimulation.hpp>
+#include <tiletwister/core/FrameStats.hpp>
+#include <tiletwister/core/InputLatency.hpp>
 #include <tiletwister/engine/GameObject.hpp>
-
-#include <tiletwister/game/Game.hpp>
-#include <tiletwister/game/Tile.hpp>
 #include <tiletwister/render/Renderer.hpp>
 
-#include <optional>
-#include <string>
-#include <unordered_map>
-#include <vector>
+#include <memory>
 
+// Main-thread side of the game: translates SDL events into InputCommands for
+// the GameSimulation thread and renders its newest snapshot. Nothing here
+// touches game state directly.
 class GameControllerObject final : public GameObject
 {
 public:
-  explicit GameControllerObject(bool *runningFlag);
+  // autoplayPolicy replaces the simulation's default autoplay policy.
+  explicit GameControllerObject(
+      bool *runningFlag, std::unique_ptr<MovePolicy> autoplayPolicy = nullptr);
 
   void setWindowSize(int w, int h)
   {
@@ -22,39 +24,44 @@ public:
     m_windowH = h;
   }
 
+  // Frame timings from the main loop, drawn as an overlay when shown (F3).
+  void setPerfStats(const FrameStats *stats, bool show)
+  {
+    m_perfStats = stats;
+    m_showPerf = show;
+  }
+  // Key presses carry latency->lastPollNs(); frames that first show a move
+  // report it back (see InputLatency).
+  void setInputLatency(InputLatency *latency) { m_latency = latency; }
+  // Starts autoplay at movesPerSec (0: one move per slide animation). A
+  // toggles it from the keyboard, +/- step through kAutoplaySpeeds.
+  void startAutoplay(int movesPerSec);
+  const RenderStats &renderStats() const
+  {
+    return m_renderer.lastFrameStats();
+  }
+
   void handleEvent(const SDL_Event &e) override;
   void update(float dtSec) override;
   void render(SDL_Renderer *renderer) override;
 
 private:
-  struct ActiveMove
-  {
-    bool active = false;
-    float timeLeft = 0.0f;
-    float duration = 0.12f;
-    std::vector<Cell> pendingPopCells;
-    std::optional<Cell> pendingSpawnCell;
-  };
+  static constexpr int kAutoplaySpeeds[] = {0,   4,    10,    30,
+                                            120, 1000, 10000, 100000};
 
   bool *m_running = nullptr;
   int m_windowW = 600;
   int m_windowH = 600;
 
-  Game m_game;
   Renderer m_renderer;
-  std::unordered_map<int, Tile> m_tiles;
-  ActiveMove m_activeMove{};
-  int m_bestScore = 0; // persists across restarts in this controller instance
-  int m_lastScore = 0;
-  int m_savedBestScore = -1;
-  int m_savedLastScore = -1;
-  std::string m_scoresPath = "scores.txt";
+  GameSimulation m_sim;
   bool m_gameOverButtonHover = false;
+  const FrameStats *m_perfStats = nullptr;
+  bool m_showPerf = false;
+  InputLatency *m_latency = nullptr;
+  std::uint32_t m_shownMoveSeq = 0;
+  int m_autoplaySpeed = 0; // used when A turns autoplay on
+  bool m_autoplayOn = false;
 
-  void rebuildTilesFromGrid();
-  void beginMove(Direction dir);
-  void loadScores();
-  void saveScoresIfNeeded(bool force);
-
-  static int keyForCellValue(int r, int c, int value, int ordinal);
+  void changeAutoplaySpeed(int steps);
 };
@@ -0,0 +1,216 @@
+#pragma once
+
+#include <tiletwister/core/AsyncFileWriter.hpp>
+#include <tiletwister/core/Metrics.hpp>
+#include <tiletwister/core/SpscQueue.hpp>
+#include <tiletwister/core/TripleBuffer.hpp>
+#include <tiletwister/game/Game.hpp>
+#include <tiletwister/game/GameHistory.hpp>
+#include <tiletwister/game/HintService.hpp>
+#include <tiletwister/game/MovePolicy.hpp>
+#include <tiletwister/game/RenderSnapshot.hpp>
+#include <tiletwister/game/TileStore.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+
+// Player input, already translated from SDL events by the main thread.
+struct InputCommand
+{
+  enum class Type : std::uint8_t
+  {
+    Press,   // arrow pressed (dir)
+    Release, // arrow released (dir)
+    Restart,
+    Hint,     // search the best move for the current board
+    Autoplay, // value: moves/sec (0 = one per slide), < 0 stops
+    Quit,     // persist everything now
+  };
+
+  Type type = Type::Press;
+  Direction dir = Direction::Left;
+  std::int64_t polledNs = 0; // when the key press was polled (latency)
+  std::int32_t value = 0;
+};
+
+// Game logic on its own thread.
+//
+// Runs the game at a fixed step (moves, animation, key repeat, persistence)
+// and publishes an immutable RenderSnapshot after every step through a
+// lock-free triple buffer. The main thread only posts InputCommands and
+// renders the newest snapshot, so a slow step (I/O, AI) never blocks a frame
+// and a slow frame never delays input.
+class GameSimulation
+{
+public:
+  static constexpr double kStepSec = 1.0 / 120.0;
+  // Autoplay above this speed skips slide/pop animation entirely and only
+  // the latest board of each published step is shown.
+  static constexpr int kMaxAnimatedMovesPerSec = 30;
+
+  GameSimulation();
+  ~GameSimulation(); // stops the thread; pending writes are flushed
+
+  GameSimulation(const GameSimulation &) = delete;
+  GameSimulation &operator=(const GameSimulation &) = delete;
+
+  // Autoplay picks moves through policy (default: ExpectimaxPolicy). Call
+  // before start().
+  void setAutoplayPolicy(std::unique_ptr<MovePolicy> policy);
+
+  void start();
+  // Processes the commands already posted, then joins the thread.
+  void stop();
+
+  // Main thread. Returns false if the command ring is full (input dropped).
+  bool post(const InputCommand &cmd)
+  {
+    if (m_commands.push(cmd))
+      return true;
+    metrics().droppedInputs.add();
+    return false;
+  }
+
+  // Main thread: swaps in the newest snapshot (if any) and returns it.
+  const RenderSnapshot &latestSnapshot()
+  {
+    m_snapshots.acquire();
+    return m_snapshots.read();
+  }
+
+  // Everything below runs on the simulation thread (or before start()).
+  void step(float dtSec);
+  void handleCommand(const InputCommand &cmd);
+  void publishSnapshot(std::uint64_t stepIndex);
+
+private:
+  static constexpr float kSlideSec = 0.12f;
+
+  struct ActiveMove
+  {
+    bool active = false;
+    float timeLeft = 0.0f;
+    float duration = kSlideSec;
+  };
+
+  struct QueuedMove
+  {
+    Direction dir = Direction::Left;
+    std::int64_t polledNs = 0; // 0 for key repeats
+  };
+
+  // Bounded FIFO of arrow presses. Moves are never dropped while a slide is
+  // animating: a queued move fast-forwards the current one instead.
+  struct InputQueue
+  {
+    static constexpr int kCapacity = 4;
+    QueuedMove items[kCapacity]{};
+    int head = 0;
+    int count = 0;
+
+    bool push(const QueuedMove &m)
+    {
+      if (count == kCapacity)
+        return false;
+      items[(head + count) % kCapacity] = m;
+      ++count;
+      return true;
+    }
+    QueuedMove pop()
+    {
+      const QueuedMove m = items[head];
+      head = (head + 1) % kCapacity;
+      --count;
+      return m;
+    }
+    void clear()
+    {
+      head = 0;
+      count = 0;
+    }
+  };
+
+  // Held arrow, repeated by us (SDL's OS-rate repeats are ignored).
+  struct HeldKey
+  {
+    bool active = false;
+    Direction dir = Direction::Left;
+    float elapsed = 0.0f;    // since the last (re)press
+    float nextRepeat = 0.0f; // elapsed time of the next repeat
+  };
+
+  static constexpr float kRepeatDelaySec = 0.18f;
+  static constexpr float kRepeatIntervalSec = 0.05f; // 20 moves/sec
+  static constexpr int kHintBudgetMs = 200;
+
+  struct Autoplay
+  {
+    bool active = false;
+    int movesPerSec = 0;      // 0: next move when the slide ends
+    float credit = 0.0f;      // moves owed at movesPerSec
+    float gameOverSec = 0.0f; // time the final board has been shown
+  };
+  // Final board stays up this long before an animated autoplay restarts.
+  static constexpr float kAutoplayRestartSec = 1.0f;
+  // Fast autoplay yields after this much work per step, dropping the moves
+  // it owes, so a slow policy lowers the speed instead of stalling steps.
+  static constexpr std::chrono::microseconds kAutoplayStepBudget{4000};
+
+  Game m_game;
+  TileStore m_tiles;
+  ActiveMove m_activeMove{};
+  InputQueue m_inputQueue{};
+  HeldKey m_heldKey{};
+  int m_bestScore = 0; // persists across restarts in this instance
+  int m_lastScore = 0;
+  int m_savedBestScore = -1;
+  int m_savedLastScore = -1;
+  std::string m_scoresPath = "scores.txt";
+  std::string m_savePath = "savegame.bin";
+  AsyncFileWriter m_fileWriter; // scores + save; flushes when destroyed
+  GameHistoryWriter m_history{"history.bin", m_fileWriter};
+  // Start of the current game, moved back by the play time of the sessions
+  // it was resumed from.
+  std::chrono::steady_clock::time_point m_gameStart;
+  bool m_gameRecorded = false; // current game already appended to history
+  HintService m_hints{kHintBudgetMs};
+  bool m_hintPending = false; // requested, result not in yet
+  bool m_hintShown = false;   // m_hintDir is valid for the current board
+  Direction m_hintDir = Direction::Left;
+  std::unique_ptr<MovePolicy> m_autoplayPolicy;
+  Autoplay m_autoplay{};
+  bool m_tilesStale = false; // fast autoplay moved past m_tiles
+  // Autoplay moved in (or started) the current game: it stays out of the
+  // scores, the history and the save, so the player's records and resumable
+  // game survive any number of bot games.
+  bool m_autoplayedGame = false;
+  std::uint32_t m_moveSeq = 0;
+  std::int64_t m_moveInputNs = 0; // poll time of the input behind m_moveSeq
+
+  SpscQueue<InputCommand, 64> m_commands;
+  TripleBuffer<RenderSnapshot> m_snapshots;
+  std::atomic<bool> m_running{false};
+  std::thread m_thread;
+
+  void run();
+  void drainCommands();
+
+  bool beginMove(const QueuedMove &move);
+  void finishActiveMove();
+  void restartGame();
+  void dropHint();
+  void stepAutoplay(float dtSec);
+  bool playAutoplayMove(bool animate);
+  void stopAutoplay();
+  void syncStaleTiles();
+  void loadScores();
+  void loadGameState();
+  void checkpointGameState();
+  std::uint32_t playedMs() const;
+  void recordFinishedGame();
+  void saveScoresIfNeeded(bool force);
+};
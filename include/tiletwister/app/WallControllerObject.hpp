@@ -0,0 +1,50 @@
+#pragma once
+
+#include <tiletwister/core/FrameStats.hpp>
+#include <tiletwister/engine/GameObject.hpp>
+#include <tiletwister/game/GameWall.hpp>
+#include <tiletwister/render/Renderer.hpp>
+
+#include <string>
+
+// Wall view: many autoplaying games in one window. The games run on the
+// GameWall's worker threads; this object only copies their packed boards
+// once per frame and draws them in one batched pass.
+class WallControllerObject final : public GameObject
+{
+public:
+  WallControllerObject(bool *runningFlag, int boards, int workers,
+                       const std::string &policy, int movesPerSec);
+
+  void setWindowSize(int w, int h)
+  {
+    m_windowW = w;
+    m_windowH = h;
+  }
+
+  // Frame timings from the main loop, drawn as an overlay when shown (F3).
+  void setPerfStats(const FrameStats *stats, bool show)
+  {
+    m_perfStats = stats;
+    m_showPerf = show;
+  }
+  const RenderStats &renderStats() const
+  {
+    return m_renderer.lastFrameStats();
+  }
+
+  void handleEvent(const SDL_Event &e) override;
+  void update(float dtSec) override;
+  void render(SDL_Renderer *renderer) override;
+
+private:
+  bool *m_running = nullptr;
+  int m_windowW = 600;
+  int m_windowH = 600;
+
+  Renderer m_renderer;
+  GameWall m_wall;
+  WallSnapshot m_snapshot; // copied out of m_wall every frame
+  const FrameStats *m_perfStats = nullptr;
+  bool m_showPerf = false;
+};
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstdint>
+
+// Heap allocation accounting.
+//
+// src/core/AllocHooks.cpp replaces the global operator new/delete with
+// versions that count every allocation (process-wide and per thread) and
+// forward to malloc/free. It is opt-in: only executables that link it
+// (tiletwister_allochooks in CMake) are counted, and only they can call
+// these functions.
+//
+//   AllocScope scope;
+//   game.tryMove(Direction::Left);
+//   assert(scope.allocations() == 0);
+namespace AllocHooks {
+
+struct Counts {
+  std::uint64_t allocations = 0;
+  std::uint64_t bytes = 0;
+};
+
+// Every thread, since startup (relaxed reads).
+Counts process();
+// The calling thread only, since it started.
+Counts thread();
+
+} // namespace AllocHooks
+
+// Allocations made by the calling thread since construction; other threads
+// (e.g. the file writer) don't disturb the count.
+class AllocScope {
+public:
+  AllocScope() : m_start(AllocHooks::thread()) {}
+
+  std::uint64_t allocations() const {
+    return AllocHooks::thread().allocations - m_start.allocations;
+  }
+  std::uint64_t bytes() const {
+    return AllocHooks::thread().bytes - m_start.bytes;
+  }
+
+private:
+  AllocHooks::Counts m_start;
+};
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+
+// Replaces path's contents atomically: writes path + ".tmp", flushes it to
+// disk (fsync / _commit) and renames it over path. Returns false on any error
+// (path is then left untouched). durable=false skips the flush: readers still
+// never see a partial file, but a crash may lose the update.
+bool writeFileAtomic(const std::string& path, const std::string& contents,
+                     bool durable = true);
+
+// Appends bytes to path (created if missing) and flushes it to disk.
+bool appendFileSynced(const std::string& path, const std::string& bytes);
+
+// Background writer for small state files (scores, saves) and append-only
+// logs.
+//
+// submit()/append() only queue the request and return; a worker thread
+// performs the writes. Requests for the same path that are still queued are
+// coalesced (a replace keeps the latest contents, appends are concatenated),
+// and the worker waits a short window after the first request of a burst so
+// rapid updates cost one write. The destructor flushes everything queued.
+class AsyncFileWriter {
+public:
+  explicit AsyncFileWriter(int coalesceMs = 50);
+  ~AsyncFileWriter();
+
+  AsyncFileWriter(const AsyncFileWriter&) = delete;
+  AsyncFileWriter& operator=(const AsyncFileWriter&) = delete;
+
+  // Atomically replaces path's contents (writeFileAtomic).
+  void submit(const std::string& path, std::string contents);
+  // Appends to path (appendFileSynced).
+  void append(const std::string& path, const std::string& bytes);
+
+  // Blocks until every request submitted so far has been written (or failed).
+  void flush();
+
+  std::uint64_t writesCompleted() const;
+  std::uint64_t writesFailed() const;
+
+private:
+  mutable std::mutex m_mutex;
+  std::condition_variable m_wake;
+  std::condition_variable m_idle;
+  struct Pending {
+    std::string data;
+    bool append = false; // false: replace the file with data
+  };
+  std::map<std::string, Pending> m_pending;
+  bool m_busy = false;
+  bool m_flushRequested = false;
+  bool m_stop = false;
+  int m_coalesceMs = 50;
+  std::uint64_t m_completed = 0;
+  std::uint64_t m_failed = 0;
+  std::thread m_thread;
+
+  void run();
+};
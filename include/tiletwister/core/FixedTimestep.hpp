@@ -0,0 +1,29 @@
+#pragma once
+
+// Fixed-step simulation clock.
+//
+// Real frame time goes into an accumulator and the simulation advances in
+// whole steps of step() seconds, so animation and input timing don't depend
+// on the display rate. alpha() is how far the rendered frame lies between
+// the last two steps. A long frame (stall, window drag, breakpoint) runs at
+// most maxStepsPerFrame steps; the rest of that time is dropped instead of
+// replayed, so the game pauses rather than jumps or spirals.
+class FixedTimestep {
+public:
+  explicit FixedTimestep(double stepSec = 1.0 / 120.0,
+                         int maxStepsPerFrame = 8);
+
+  // Adds one frame's real time; returns how many steps to simulate now.
+  int advance(double frameSec);
+
+  double step() const { return m_step; }
+  float alpha() const { return static_cast<float>(m_accumulator / m_step); }
+  // Total real time dropped by the per-frame step limit.
+  double droppedSec() const { return m_dropped; }
+
+private:
+  double m_step;
+  int m_maxSteps;
+  double m_accumulator = 0.0;
+  double m_dropped = 0.0;
+};
@@ -0,0 +1,44 @@
+#pragma once
+
+// One frame of the main loop, in milliseconds unless noted.
+struct FrameSample {
+  float frameMs = 0.0f;   // start of this frame to the start of the next
+  float updateMs = 0.0f;  // event handling + simulation steps
+  float renderMs = 0.0f;  // building the frame (Scene::render)
+  float presentMs = 0.0f; // SDL_RenderPresent, including any vsync wait
+  int drawCalls = 0;
+  int allocations = 0; // heap allocations during the frame (all threads)
+};
+
+// Rolling window of the last kHistory frames, for the performance overlay.
+// Fixed storage: pushing a frame never allocates.
+class FrameStats {
+public:
+  static constexpr int kHistory = 120;
+
+  void push(const FrameSample& s) {
+    m_samples[m_next] = s;
+    m_next = (m_next + 1) % kHistory;
+    if (m_count < kHistory) ++m_count;
+  }
+  void clear() {
+    m_next = 0;
+    m_count = 0;
+  }
+
+  int count() const { return m_count; }
+  // i = 0 is the oldest frame in the window, count() - 1 the newest.
+  const FrameSample& at(int i) const {
+    return m_samples[(m_next - m_count + i + kHistory) % kHistory];
+  }
+
+  // Field-wise mean over the window (counts are rounded).
+  FrameSample average() const;
+  float maxFrameMs() const;
+  float fps() const;
+
+private:
+  FrameSample m_samples[kHistory]{};
+  int m_next = 0;
+  int m_count = 0;
+};
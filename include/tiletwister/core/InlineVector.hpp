@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+
+// Vector with fixed inline storage for hot-path results whose size has a
+// small known bound (e.g. at most 16 tiles slide per move). Never allocates;
+// pushing past Capacity is a bug (asserted).
+template <class T, std::size_t Capacity>
+class InlineVector {
+public:
+  void push_back(const T& v) {
+    assert(m_size < Capacity);
+    m_items[m_size++] = v;
+  }
+  void clear() { m_size = 0; }
+
+  std::size_t size() const { return m_size; }
+  bool empty() const { return m_size == 0; }
+  static constexpr std::size_t capacity() { return Capacity; }
+
+  T& operator[](std::size_t i) { return m_items[i]; }
+  const T& operator[](std::size_t i) const { return m_items[i]; }
+
+  T* begin() { return m_items; }
+  T* end() { return m_items + m_size; }
+  const T* begin() const { return m_items; }
+  const T* end() const { return m_items + m_size; }
+
+private:
+  T m_items[Capacity]{};
+  std::size_t m_size = 0;
+};
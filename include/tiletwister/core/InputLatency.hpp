@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstdint>
+
+// Input-to-photon latency: from the moment a key press is polled to the
+// first present of a frame that shows the move it caused.
+//
+// The poll timestamp travels with the input (command -> move -> snapshot);
+// the renderer reports which input the frame it drew shows, and the main
+// loop closes the measurement right after SDL_RenderPresent. Main thread
+// only; the last kWindow samples are kept for percentiles.
+class InputLatency {
+public:
+  static constexpr int kWindow = 256;
+
+  // steady_clock, the time base of every timestamp here.
+  static std::int64_t nowNs();
+
+  // Main loop: a key press was just polled.
+  void keyPolled(std::int64_t ns) { m_lastPollNs = ns; }
+  std::int64_t lastPollNs() const { return m_lastPollNs; }
+
+  // Renderer: the frame being drawn is the first to show the move caused by
+  // the input polled at inputNs (0 = not caused by a polled key, e.g. key
+  // repeat).
+  void frameShowsInput(std::int64_t inputNs) {
+    if (inputNs > 0) m_pendingInputNs = inputNs;
+  }
+  // Main loop, right after present. Returns true if a sample was recorded.
+  bool presented(std::int64_t ns);
+
+  void record(std::int64_t latencyNs);
+
+  // Over the last kWindow samples; 0 if none.
+  float percentileMs(double q) const;
+  std::uint64_t count() const { return m_total; }
+
+private:
+  std::int64_t m_lastPollNs = 0;
+  std::int64_t m_pendingInputNs = 0;
+  std::int64_t m_samples[kWindow]{};
+  int m_next = 0;
+  int m_filled = 0;
+  std::uint64_t m_total = 0;
+};
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+// Read-only memory mapping of a whole file (mmap / CreateFileMapping).
+// An empty or missing file maps to data() == nullptr, size() == 0.
+class MappedFile {
+public:
+  MappedFile() = default;
+  ~MappedFile();
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  bool open(const std::string& path);
+  void close();
+
+  const unsigned char* data() const { return m_data; }
+  std::size_t size() const { return m_size; }
+
+private:
+  const unsigned char* m_data = nullptr;
+  std::size_t m_size = 0;
+#ifdef _WIN32
+  void* m_file = nullptr;
+  void* m_mapping = nullptr;
+#endif
+};
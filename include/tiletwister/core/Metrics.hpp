@@ -0,0 +1,82 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+// In-process runtime metrics for fleet monitoring.
+//
+// Updates are single relaxed atomic operations, so any thread (frame loop,
+// simulation, file writer) can record without locks or allocation. A
+// MetricsExporter thread reads them and publishes text.
+class Counter {
+public:
+  void add(std::uint64_t n = 1) {
+    m_value.fetch_add(n, std::memory_order_relaxed);
+  }
+  std::uint64_t value() const {
+    return m_value.load(std::memory_order_relaxed);
+  }
+
+private:
+  std::atomic<std::uint64_t> m_value{0};
+};
+
+class Gauge {
+public:
+  void set(std::int64_t v) { m_value.store(v, std::memory_order_relaxed); }
+  std::int64_t value() const {
+    return m_value.load(std::memory_order_relaxed);
+  }
+
+private:
+  std::atomic<std::int64_t> m_value{0};
+};
+
+// Log-linear histogram of non-negative integer samples (e.g. microseconds):
+// values below 4 are exact, larger ones fall into 4 buckets per power of two
+// (<= 12.5% error). Fixed size, lock-free.
+class Histogram {
+public:
+  static constexpr int kBuckets = 128;
+
+  // Plain copy of the bucket counts; subtract two to get an interval.
+  struct Snapshot {
+    std::uint64_t buckets[kBuckets]{};
+    std::uint64_t count = 0;
+    std::uint64_t sum = 0;
+
+    Snapshot since(const Snapshot& earlier) const;
+    // Value at quantile q (0..1), as the midpoint of its bucket; 0 if empty.
+    std::uint64_t quantile(double q) const;
+  };
+
+  void record(std::uint64_t v) {
+    m_buckets[bucketOf(v)].fetch_add(1, std::memory_order_relaxed);
+    m_sum.fetch_add(v, std::memory_order_relaxed);
+  }
+  Snapshot snapshot() const;
+
+  static int bucketOf(std::uint64_t v);
+  static std::uint64_t bucketLow(int bucket);
+
+private:
+  std::atomic<std::uint64_t> m_buckets[kBuckets]{};
+  std::atomic<std::uint64_t> m_sum{0};
+};
+
+struct Metrics {
+  Counter moves;         // moves that changed the board
+  Counter games;         // finished (or abandoned) games recorded
+  Counter frames;        // frames presented
+  Counter droppedInputs; // input lost to a full command ring / move queue
+  Counter saves;         // background writes (scores, save, history)
+  Counter saveFailures;
+  Gauge score;
+  Gauge bestScore;
+  Histogram frameTimeUs;    // full frame, pacing included
+  Histogram saveLatencyUs;  // one write + fsync on the file writer thread
+  Histogram inputLatencyUs; // key poll to first present showing the move
+};
+
+// The process-wide instance the game records into.
+Metrics& metrics();
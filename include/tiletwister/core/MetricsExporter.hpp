@@ -0,0 +1,59 @@
+#pragma once
+
+#include <tiletwister/core/Metrics.hpp>
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+
+// Publishes a Metrics instance for a local monitoring agent.
+//
+// A background thread renders the metrics as Prometheus-style text every
+// interval and
+// - atomically replaces filePath with it (readers never see a partial file),
+// - and/or serves it to every client connecting to the Unix domain socket
+//   socketPath (POSIX only): one response per connection, then close.
+// Quantiles are over the last interval; counters are totals. The recording
+// side only ever touches relaxed atomics, and the socket is non-blocking, so
+// a stuck scraper can't stall the game.
+class MetricsExporter {
+public:
+  MetricsExporter(const Metrics& m, std::string filePath,
+                  std::string socketPath, int intervalMs = 1000);
+  ~MetricsExporter(); // stop()
+
+  MetricsExporter(const MetricsExporter&) = delete;
+  MetricsExporter& operator=(const MetricsExporter&) = delete;
+
+  // Returns false (and exports nothing) if the socket can't be set up.
+  bool start();
+  void stop();
+
+  // Renders the text for the interval since the previous render (tests).
+  std::string render();
+
+private:
+  const Metrics& m_metrics;
+  std::string m_filePath;
+  std::string m_socketPath;
+  std::chrono::milliseconds m_interval;
+  const std::chrono::steady_clock::time_point m_startTime;
+  Histogram::Snapshot m_lastFrames;
+  Histogram::Snapshot m_lastSaves;
+  Histogram::Snapshot m_lastInputs;
+  std::string m_published; // text served to socket clients
+  int m_listenFd = -1;
+
+  std::mutex m_mutex;
+  std::condition_variable m_wake;
+  bool m_stop = false;
+  std::thread m_thread;
+
+  bool openSocket();
+  void closeSocket();
+  void serveClients();
+  void publish();
+  void run();
+};
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstdint>
+
+// Small PRNG with a single 64-bit state word (SplitMix64), so a game's random
+// stream can be saved/restored as one integer and each board can own one
+// (no shared global generator between threads).
+class Rng {
+public:
+  explicit Rng(std::uint64_t seed = 0) : m_state(seed) {}
+
+  std::uint64_t next() {
+    std::uint64_t z = (m_state += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+  }
+
+  // Uniform in [0, n) for n > 0 (multiply-shift; bias is negligible for the
+  // small ranges used here).
+  int below(int n) {
+    const std::uint64_t hi = next() >> 32;
+    return static_cast<int>((hi * static_cast<std::uint64_t>(n)) >> 32);
+  }
+
+  // True with probability numerator/denominator.
+  bool chance(int numerator, int denominator) {
+    if (denominator <= 0) return false;
+    return below(denominator) < numerator;
+  }
+
+  std::uint64_t state() const { return m_state; }
+  void setState(std::uint64_t s) { m_state = s; }
+
+private:
+  std::uint64_t m_state;
+};
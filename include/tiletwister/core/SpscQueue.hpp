@@ -0,0 +1,37 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+// Fixed-capacity lock-free single-producer / single-consumer ring.
+// Capacity must be a power of two; push() fails (drops) when full.
+template <class T, std::size_t Capacity>
+class SpscQueue {
+  static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0,
+                "capacity must be a power of two");
+
+public:
+  // Producer thread only.
+  bool push(const T& value) {
+    const std::size_t tail = m_tail.load(std::memory_order_relaxed);
+    if (tail - m_head.load(std::memory_order_acquire) == Capacity)
+      return false;
+    m_items[tail & (Capacity - 1)] = value;
+    m_tail.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Consumer thread only.
+  bool pop(T& out) {
+    const std::size_t head = m_head.load(std::memory_order_relaxed);
+    if (head == m_tail.load(std::memory_order_acquire)) return false;
+    out = m_items[head & (Capacity - 1)];
+    m_head.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+private:
+  T m_items[Capacity]{};
+  alignas(64) std::atomic<std::size_t> m_head{0};
+  alignas(64) std::atomic<std::size_t> m_tail{0};
+};
@@ -0,0 +1,113 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+#if defined(TILETWISTER_ENABLE_TRACING) && \
+    (defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || \
+     defined(_M_IX86))
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#define TILETWISTER_TRACE_TSC 1
+#else
+#include <chrono>
+#endif
+
+// Scoped trace zones, exported as Chrome trace-event JSON (chrome://tracing,
+// Perfetto).
+//
+//   TT_TRACE_SCOPE("Renderer::tiles");  // times the enclosing scope
+//   TT_TRACE_THREAD("simulation");      // names the calling thread
+//
+// Built only with TILETWISTER_ENABLE_TRACING (CMake option of the same name);
+// otherwise the macros expand to nothing. When enabled, a zone costs two
+// timestamp reads (TSC on x86), three relaxed stores into the calling
+// thread's own ring buffer and a release store of its head: no locks, no
+// allocation. Each ring keeps the last kRingEvents zones; writeChromeTrace()
+// can run on any thread while others keep recording.
+namespace Trace {
+
+#if defined(TILETWISTER_ENABLE_TRACING)
+constexpr bool kEnabled = true;
+#else
+constexpr bool kEnabled = false;
+#endif
+
+// Writes every ring's events to path. Returns false if tracing is compiled
+// out or the file can't be written.
+bool writeChromeTrace(const std::string& path);
+
+void setThreadName(const char* name);
+
+namespace detail {
+
+constexpr std::uint32_t kRingEvents = 1u << 14;
+
+struct Event {
+  std::atomic<const char*> name{nullptr};
+  std::atomic<std::uint64_t> begin{0};
+  std::atomic<std::uint64_t> end{0};
+};
+
+struct ThreadRing {
+  std::atomic<std::uint64_t> head{0}; // events ever written
+  std::uint32_t tid = 0;
+  std::atomic<const char*> threadName{nullptr};
+  Event events[kRingEvents];
+};
+
+// Registers (or recycles) the calling thread's ring.
+ThreadRing* attachThread();
+
+inline thread_local ThreadRing* t_ring = nullptr;
+
+inline std::uint64_t now() {
+#if defined(TILETWISTER_TRACE_TSC)
+  return __rdtsc();
+#else
+  return static_cast<std::uint64_t>(
+      std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+}
+
+inline void record(const char* name, std::uint64_t begin, std::uint64_t end) {
+  ThreadRing* ring = t_ring ? t_ring : attachThread();
+  const std::uint64_t h = ring->head.load(std::memory_order_relaxed);
+  Event& e = ring->events[h & (kRingEvents - 1)];
+  e.name.store(name, std::memory_order_relaxed);
+  e.begin.store(begin, std::memory_order_relaxed);
+  e.end.store(end, std::memory_order_relaxed);
+  ring->head.store(h + 1, std::memory_order_release);
+}
+
+class Zone {
+public:
+  explicit Zone(const char* name) : m_name(name), m_begin(now()) {}
+  ~Zone() { record(m_name, m_begin, now()); }
+
+  Zone(const Zone&) = delete;
+  Zone& operator=(const Zone&) = delete;
+
+private:
+  const char* m_name;
+  std::uint64_t m_begin;
+};
+
+} // namespace detail
+} // namespace Trace
+
+#if defined(TILETWISTER_ENABLE_TRACING)
+#define TT_TRACE_CONCAT_(a, b) a##b
+#define TT_TRACE_CONCAT(a, b) TT_TRACE_CONCAT_(a, b)
+// name must be a string literal (only the pointer is stored).
+#define TT_TRACE_SCOPE(name) \
+  ::Trace::detail::Zone TT_TRACE_CONCAT(ttTraceZone_, __LINE__)(name)
+#define TT_TRACE_THREAD(name) ::Trace::setThreadName(name)
+#else
+#define TT_TRACE_SCOPE(name) ((void)0)
+#define TT_TRACE_THREAD(name) ((void)0)
+#endif
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+// Lock-free single-producer / single-consumer triple buffer.
+//
+// The writer fills writeBuffer() and publish()es it; the reader calls
+// acquire() and then reads read(). Three slots rotate through one atomic
+// exchange on each side, so neither thread ever waits for the other: the
+// writer always has a free slot, and the reader always sees the newest
+// complete value (intermediate ones are skipped). No locks, no allocation.
+template <class T>
+class TripleBuffer {
+public:
+  // Writer thread only.
+  T& writeBuffer() { return m_slots[m_back]; }
+  void publish() {
+    const std::uint8_t old =
+        m_middle.exchange(static_cast<std::uint8_t>(m_back | kFresh),
+                          std::memory_order_acq_rel);
+    m_back = old & kIndexMask;
+  }
+
+  // Reader thread only. Swaps in the newest published value, if any; returns
+  // true if read() changed.
+  bool acquire() {
+    if (!(m_middle.load(std::memory_order_relaxed) & kFresh)) return false;
+    const std::uint8_t old =
+        m_middle.exchange(m_front, std::memory_order_acq_rel);
+    m_front = old & kIndexMask;
+    return true;
+  }
+  const T& read() const { return m_slots[m_front]; }
+
+private:
+  static constexpr std::uint8_t kIndexMask = 0x3;
+  static constexpr std::uint8_t kFresh = 0x4;
+
+  T m_slots[3]{};
+  std::uint8_t m_back = 0;  // writer-owned slot
+  alignas(64) std::atomic<std::uint8_t> m_middle{1};
+  alignas(64) std::uint8_t m_front = 2; // reader-owned slot
+};
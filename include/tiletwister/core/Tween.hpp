@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+enum class Easing : std::uint8_t { Linear, OutCubic, Pulse };
+
+// Stable reference to a tween. Stale once the tween finishes or is stopped
+// (the slot's generation moves on), so it is safe to keep after completion.
+struct TweenHandle {
+  std::uint32_t slot = ~0u;
+  std::uint32_t generation = 0;
+};
+
+// Structure-of-arrays tween pool.
+//
+// Active tweens are packed into contiguous arrays (start, end, t, 1/duration,
+// easing, current value) and advanced together in one pass per frame. Each
+// tween animates two floats (e.g. row/col, or scale + unused). Slots are
+// recycled through a free list; storage only grows past the initial capacity.
+//
+// Easing:
+// - Linear / OutCubic: start -> end
+// - Pulse: start -> end -> start (ease out to the peak at t=0.5, then back)
+class TweenPool {
+public:
+  explicit TweenPool(int capacity = 64);
+
+  TweenHandle start(float from0, float from1, float to0, float to1,
+                    float durationSec, Easing easing);
+  void stop(TweenHandle h);
+  void clear();
+
+  bool active(TweenHandle h) const;
+  // Current eased value (as of the last update). Returns false (outputs
+  // untouched) if the tween is no longer active.
+  bool value(TweenHandle h, float& out0, float& out1) const;
+  // Value blended between the previous and the last update (alpha in [0, 1],
+  // 1 = value()), for rendering between fixed simulation steps.
+  bool sample(TweenHandle h, float alpha, float& out0, float& out1) const;
+
+  // Advances every active tween and retires the finished ones.
+  void update(float dtSec);
+
+  int size() const { return static_cast<int>(m_t.size()); }
+
+private:
+  // Dense, per active tween.
+  std::vector<float> m_from0, m_from1, m_to0, m_to1;
+  std::vector<float> m_t, m_invDuration;
+  std::vector<float> m_value0, m_value1;
+  std::vector<float> m_prev0, m_prev1; // value before the last update
+  std::vector<Easing> m_easing;
+  std::vector<std::uint32_t> m_denseSlot; // dense index -> slot
+
+  // Sparse, per slot.
+  std::vector<std::uint32_t> m_slotDense; // slot -> dense index (or ~0u)
+  std::vector<std::uint32_t> m_generation;
+  std::vector<std::uint32_t> m_freeSlots;
+
+  void removeDense(std::uint32_t dense);
+  void evaluate(std::uint32_t begin, std::uint32_t end);
+};
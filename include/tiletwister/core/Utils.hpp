@@ -17,6 +17,25 @@ float clampf(float v, float lo, float hi);
 float lerp(float a, float b, float t);
 float easeOutCubic(float t);
 
+// Text
+// Writes the decimal form of value into out (NUL-terminated, no allocation).
+// Returns the number of characters written (excluding the NUL), or 0 if cap is
+// too small. 12 bytes fit any int.
+int formatInt(int value, char* out, int cap);
+
+// Tiles
+// floor(log2(value)) for value > 0 (exact exponent for 2048 tiles), 0 otherwise.
+inline int tileExponent(int value) {
+  if (value <= 0) return 0;
+#if defined(__GNUC__) || defined(__clang__)
+  return 31 - __builtin_clz(static_cast<unsigned>(value));
+#else
+  int e = 0;
+  while (value >>= 1) ++e;
+  return e;
+#endif
+}
+
 // Board helpers (4x4 2048 grid)
 std::vector<std::pair<int, int>> emptyCells(const int grid[4][4]);
 
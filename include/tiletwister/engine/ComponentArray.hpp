@@ -0,0 +1,95 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+// Sparse set of one component type, keyed by entity index.
+//
+// Components live densely packed (no holes), so systems iterate data()/size()
+// linearly. A sparse entity -> dense index table makes has/get/remove O(1);
+// remove swaps the last component into the hole.
+template <class T>
+class ComponentArray {
+public:
+  static constexpr std::uint32_t kNone = ~0u;
+
+  T& add(std::uint32_t entity, T value) {
+    if (entity >= m_sparse.size()) m_sparse.resize(entity + 1, kNone);
+    std::uint32_t& slot = m_sparse[entity];
+    if (slot != kNone) {
+      m_dense[slot] = std::move(value);
+      return m_dense[slot];
+    }
+    slot = static_cast<std::uint32_t>(m_dense.size());
+    m_dense.push_back(std::move(value));
+    m_entities.push_back(entity);
+    return m_dense.back();
+  }
+
+  void remove(std::uint32_t entity) {
+    if (!has(entity)) return;
+    const std::uint32_t slot = m_sparse[entity];
+    const std::uint32_t last = static_cast<std::uint32_t>(m_dense.size() - 1);
+    if (slot != last) {
+      m_dense[slot] = std::move(m_dense[last]);
+      m_entities[slot] = m_entities[last];
+      m_sparse[m_entities[slot]] = slot;
+    }
+    m_dense.pop_back();
+    m_entities.pop_back();
+    m_sparse[entity] = kNone;
+  }
+
+  bool has(std::uint32_t entity) const {
+    return entity < m_sparse.size() && m_sparse[entity] != kNone;
+  }
+
+  T& get(std::uint32_t entity) { return m_dense[m_sparse[entity]]; }
+  const T& get(std::uint32_t entity) const { return m_dense[m_sparse[entity]]; }
+  T* find(std::uint32_t entity) { return has(entity) ? &get(entity) : nullptr; }
+
+  std::size_t size() const { return m_dense.size(); }
+  T* data() { return m_dense.data(); }
+  const T* data() const { return m_dense.data(); }
+  // Entity index owning data()[i].
+  std::uint32_t entityAt(std::size_t i) const { return m_entities[i]; }
+
+  void clear() {
+    m_dense.clear();
+    m_entities.clear();
+    m_sparse.clear();
+  }
+
+  // Reorders the dense arrays (e.g. by draw layer); O(n log n), call only
+  // when the order actually went stale.
+  template <class Less>
+  void sort(Less less) {
+    std::vector<std::uint32_t> order(m_dense.size());
+    std::iota(order.begin(), order.end(), 0u);
+    std::stable_sort(order.begin(), order.end(),
+                     [&](std::uint32_t a, std::uint32_t b) {
+                       return less(m_dense[a], m_dense[b]);
+                     });
+    std::vector<T> dense;
+    std::vector<std::uint32_t> entities;
+    dense.reserve(order.size());
+    entities.reserve(order.size());
+    for (std::uint32_t i : order) {
+      dense.push_back(std::move(m_dense[i]));
+      entities.push_back(m_entities[i]);
+    }
+    m_dense.swap(dense);
+    m_entities.swap(entities);
+    for (std::uint32_t i = 0; i < m_entities.size(); ++i)
+      m_sparse[m_entities[i]] = i;
+  }
+
+private:
+  std::vector<T> m_dense;
+  std::vector<std::uint32_t> m_entities; // dense index -> entity
+  std::vector<std::uint32_t> m_sparse;   // entity -> dense index (or kNone)
+};
@@ -0,0 +1,118 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// Routes events to the handlers subscribed to their type only, instead of
+// offering every event to every object. Event is SDL_Event in the app; the
+// type key is passed alongside so this header needs no SDL definitions.
+template <class Event>
+class EventBus {
+public:
+  using Handler = std::function<void(const Event&)>;
+
+  struct Subscription {
+    std::uint32_t type = 0;
+    std::uint32_t id = 0; // 0 = none
+  };
+
+  // During a dispatch the new handler is queued; it first runs on the next
+  // event.
+  Subscription subscribe(std::uint32_t type, Handler handler) {
+    const std::uint32_t id = ++m_lastId;
+    if (m_dispatching > 0)
+      m_pending.push_back(Pending{type, Entry{id, std::move(handler)}});
+    else
+      m_handlers[type].push_back(Entry{id, std::move(handler)});
+    return Subscription{type, id};
+  }
+
+  // During a dispatch the handler is only marked dead (it may be the one
+  // running) and is erased once the dispatch returns.
+  void unsubscribe(Subscription sub) {
+    if (m_dispatching > 0) {
+      m_pending.erase(std::remove_if(m_pending.begin(), m_pending.end(),
+                                     [&](const Pending& p) {
+                                       return p.entry.id == sub.id;
+                                     }),
+                      m_pending.end());
+    }
+    auto it = m_handlers.find(sub.type);
+    if (it == m_handlers.end()) return;
+    auto& list = it->second;
+    if (m_dispatching > 0) {
+      for (Entry& e : list)
+        if (e.id == sub.id) {
+          e.id = 0;
+          m_hasDead = true;
+        }
+      return;
+    }
+    list.erase(std::remove_if(list.begin(), list.end(),
+                              [&](const Entry& e) { return e.id == sub.id; }),
+               list.end());
+  }
+
+  // Calls the type's handlers in subscription order. Returns how many ran.
+  // Handlers may (un)subscribe and dispatch: the handler lists don't change
+  // until the outermost dispatch returns.
+  int dispatch(std::uint32_t type, const Event& e) {
+    auto it = m_handlers.find(type);
+    if (it == m_handlers.end()) return 0;
+    ++m_dispatching;
+    const auto& list = it->second;
+    int ran = 0;
+    for (const Entry& entry : list) {
+      if (entry.id == 0) continue; // unsubscribed by an earlier handler
+      entry.handler(e);
+      ++ran;
+    }
+    if (--m_dispatching == 0) applyPending();
+    return ran;
+  }
+
+  void clear() {
+    if (m_dispatching == 0) {
+      m_handlers.clear();
+      return;
+    }
+    m_pending.clear();
+    for (auto& [type, list] : m_handlers)
+      for (Entry& e : list) e.id = 0;
+    m_hasDead = true;
+  }
+
+private:
+  struct Entry {
+    std::uint32_t id;
+    Handler handler;
+  };
+
+  struct Pending {
+    std::uint32_t type;
+    Entry entry;
+  };
+
+  std::unordered_map<std::uint32_t, std::vector<Entry>> m_handlers;
+  std::vector<Pending> m_pending; // subscribed during a dispatch
+  int m_dispatching = 0;          // nesting depth
+  bool m_hasDead = false;         // unsubscribed during a dispatch
+  std::uint32_t m_lastId = 0;
+
+  void applyPending() {
+    if (m_hasDead) {
+      m_hasDead = false;
+      for (auto& [type, list] : m_handlers)
+        list.erase(std::remove_if(list.begin(), list.end(),
+                                  [](const Entry& e) { return e.id == 0; }),
+                   list.end());
+    }
+    for (Pending& p : m_pending)
+      m_handlers[p.type].push_back(std::move(p.entry));
+    m_pending.clear();
+  }
+};
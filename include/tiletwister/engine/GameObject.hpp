@@ -1,9 +1,13 @@
 #pragma once
 
+#include <cstdint>
+
 // Keep the engine layer light: forward declare SDL types.
 struct SDL_Renderer;
 union SDL_Event;
 
+class ObjectPool;
+
 class GameObject {
 public:
   virtual ~GameObject() = default;
@@ -16,8 +20,20 @@ public:
   virtual void render(SDL_Renderer* renderer) = 0;
 
   // Optional: ordering / lifetime
+  // zIndex() is read when the object is added to a Scene; call
+  // zIndexChanged() whenever it starts returning something else.
   virtual int zIndex() const { return 0; }
   virtual bool alive() const { return true; }
-};
 
+  void zIndexChanged() { m_zDirty = true; }
 
+private:
+  friend class Scene;
+
+  // Scene bookkeeping.
+  std::uint64_t m_sceneSeq = 0; // insertion order (render tie-break)
+  int m_sceneZ = 0;             // cached zIndex()
+  bool m_zDirty = false;
+  bool m_dead = false;          // skipped until the scene compacts
+  ObjectPool* m_pool = nullptr; // storage, or nullptr for plain new/delete
+};
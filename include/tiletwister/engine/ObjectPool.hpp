@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <vector>
+
+// Fixed-size block allocator for one size class.
+//
+// Memory is carved from chunks of kBlocksPerChunk blocks and recycled through
+// an intrusive free list, so spawning and killing many short-lived objects
+// (particles, HUD widgets) doesn't hit the general-purpose heap per object.
+// Chunks are only released when the pool is destroyed; every block must have
+// been returned (its object destroyed) by then.
+class ObjectPool {
+public:
+  static constexpr std::size_t kBlocksPerChunk = 256;
+
+  explicit ObjectPool(std::size_t blockSize)
+      : m_blockSize(roundUp(blockSize < sizeof(FreeBlock) ? sizeof(FreeBlock)
+                                                          : blockSize)) {}
+
+  ObjectPool(const ObjectPool&) = delete;
+  ObjectPool& operator=(const ObjectPool&) = delete;
+
+  void* allocate() {
+    if (!m_free) grow();
+    FreeBlock* b = m_free;
+    m_free = b->next;
+    ++m_live;
+    return b;
+  }
+
+  void deallocate(void* p) {
+    auto* b = static_cast<FreeBlock*>(p);
+    b->next = m_free;
+    m_free = b;
+    --m_live;
+  }
+
+  std::size_t blockSize() const { return m_blockSize; }
+  std::size_t live() const { return m_live; }
+  std::size_t capacity() const { return m_chunks.size() * kBlocksPerChunk; }
+
+private:
+  struct FreeBlock {
+    FreeBlock* next;
+  };
+  struct alignas(std::max_align_t) Block {
+    unsigned char bytes[alignof(std::max_align_t)];
+  };
+
+  static std::size_t roundUp(std::size_t n) {
+    const std::size_t a = alignof(std::max_align_t);
+    return (n + a - 1) / a * a;
+  }
+
+  void grow() {
+    const std::size_t blocks = m_blockSize / sizeof(Block) * kBlocksPerChunk;
+    m_chunks.emplace_back(new Block[blocks]);
+    auto* base = reinterpret_cast<unsigned char*>(m_chunks.back().get());
+    // Thread the new blocks onto the free list in address order.
+    for (std::size_t i = kBlocksPerChunk; i-- > 0;) {
+      auto* b = reinterpret_cast<FreeBlock*>(base + i * m_blockSize);
+      b->next = m_free;
+      m_free = b;
+    }
+  }
+
+  std::size_t m_blockSize;
+  FreeBlock* m_free = nullptr;
+  std::size_t m_live = 0;
+  std::vector<std::unique_ptr<Block[]>> m_chunks;
+};
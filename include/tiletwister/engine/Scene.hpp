@@ -1,41 +1,211 @@
 #pragma once
 
+#include <tiletwister/core/Trace.hpp>
+#include <tiletwister/engine/EventBus.hpp>
 #include <tiletwister/engine/GameObject.hpp>
+#include <tiletwister/engine/ObjectPool.hpp>
+#include <tiletwister/engine/System.hpp>
+#include <tiletwister/engine/World.hpp>
 
 #include <algorithm>
+#include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
+// Owns GameObjects; updates them in insertion order and renders them by
+// zIndex() (ties in insertion order).
+//
+// - The render order is a cached array sorted by (z, insertion). It is only
+//   re-sorted after an add that breaks the order or a zIndexChanged().
+// - Objects whose alive() turns false are skipped immediately and destroyed
+//   in batches, once dead objects make up a quarter of the scene.
+// - spawn<T>() places objects in per-size-class ObjectPools instead of the
+//   general heap; add() takes heap-allocated objects as before.
+//
+// It also hosts the data-oriented layer: a World of components, the Systems
+// that process it, and an EventBus. Events go to the bus subscribers of their
+// type and to every GameObject.
 class Scene {
 public:
-  void add(std::unique_ptr<GameObject> obj) { m_objects.emplace_back(std::move(obj)); }
+  Scene() = default;
+  ~Scene() { clear(); }
 
-  void handleEvent(const SDL_Event& e) {
-    for (auto& o : m_objects) o->handleEvent(e);
+  Scene(const Scene&) = delete;
+  Scene& operator=(const Scene&) = delete;
+
+  void add(std::unique_ptr<GameObject> obj) { adopt(obj.release()); }
+
+  // Constructs a T in pooled storage and adds it. The scene owns the result.
+  template <class T, class... Args>
+  T* spawn(Args&&... args) {
+    static_assert(std::is_base_of<GameObject, T>::value,
+                  "spawn<T> requires a GameObject");
+    if constexpr (sizeof(T) > kMaxPooledSize ||
+                  alignof(T) > alignof(std::max_align_t)) {
+      T* obj = new T(std::forward<Args>(args)...);
+      adopt(obj);
+      return obj;
+    } else {
+      ObjectPool& pool = poolFor(sizeof(T));
+      void* mem = pool.allocate();
+      T* obj = nullptr;
+      try {
+        obj = new (mem) T(std::forward<Args>(args)...);
+      } catch (...) {
+        pool.deallocate(mem);
+        throw;
+      }
+      obj->m_pool = &pool;
+      adopt(obj);
+      return obj;
+    }
+  }
+
+  // Systems update after the GameObjects, in the order added.
+  template <class T>
+  T& addSystem(std::unique_ptr<T> system) {
+    T& ref = *system;
+    const int z = ref.zIndex();
+    auto it = std::upper_bound(
+        m_systemRenderOrder.begin(), m_systemRenderOrder.end(), z,
+        [](int zz, const System* s) { return zz < s->zIndex(); });
+    m_systemRenderOrder.insert(it, &ref);
+    m_systems.push_back(std::move(system));
+    return ref;
   }
 
+  World& world() { return m_world; }
+  EventBus<SDL_Event>& events() { return m_events; }
+
+  // Live objects (dead ones awaiting compaction are not counted).
+  std::size_t size() const { return m_objects.size() - m_deadCount; }
+
+  void clear() {
+    for (GameObject* o : m_objects) destroy(o);
+    m_objects.clear();
+    m_renderOrder.clear();
+    m_deadCount = 0;
+    m_orderDirty = false;
+  }
+
+  // Defined in Scene.cpp (needs SDL_Event's definition for the type).
+  void handleEvent(const SDL_Event& e);
+
   void update(float dtSec) {
-    for (auto& o : m_objects) o->update(dtSec);
-    // Remove dead objects
-    m_objects.erase(std::remove_if(m_objects.begin(), m_objects.end(),
-                                   [](const std::unique_ptr<GameObject>& o) {
-                                     return !o->alive();
-                                   }),
-                    m_objects.end());
+    TT_TRACE_SCOPE("Scene::update");
+    const std::size_t n = m_objects.size();
+    for (std::size_t i = 0; i < n; ++i) {
+      GameObject* o = m_objects[i];
+      if (o->m_dead) continue;
+      o->update(dtSec);
+      if (!o->alive()) {
+        o->m_dead = true;
+        ++m_deadCount;
+      } else if (o->m_zDirty) {
+        o->m_zDirty = false;
+        const int z = o->zIndex();
+        if (z != o->m_sceneZ) {
+          o->m_sceneZ = z;
+          m_orderDirty = true;
+        }
+      }
+    }
+    if (m_deadCount > 0 && m_deadCount * 4 >= m_objects.size()) compact();
+
+    for (auto& sys : m_systems) sys->update(m_world, dtSec);
   }
 
   void render(SDL_Renderer* r) {
-    // Stable sort by zIndex each frame (small N for this project).
-    std::stable_sort(m_objects.begin(), m_objects.end(),
-                     [](const std::unique_ptr<GameObject>& a,
-                        const std::unique_ptr<GameObject>& b) {
-                       return a->zIndex() < b->zIndex();
-                     });
-    for (auto& o : m_objects) o->render(r);
+    TT_TRACE_SCOPE("Scene::render");
+    if (m_orderDirty) {
+      std::sort(m_renderOrder.begin(), m_renderOrder.end(), renderBefore);
+      m_orderDirty = false;
+    }
+    // Merge systems in by z; on equal z they draw after the objects.
+    std::size_t next = 0;
+    const std::size_t systems = m_systemRenderOrder.size();
+    for (GameObject* o : m_renderOrder) {
+      if (o->m_dead) continue;
+      while (next < systems &&
+             m_systemRenderOrder[next]->zIndex() < o->m_sceneZ)
+        m_systemRenderOrder[next++]->render(m_world, r);
+      o->render(r);
+    }
+    while (next < systems) m_systemRenderOrder[next++]->render(m_world, r);
   }
 
 private:
-  std::vector<std::unique_ptr<GameObject>> m_objects;
-};
+  static constexpr std::size_t kPoolGranularity = alignof(std::max_align_t);
+  static constexpr std::size_t kMaxPooledSize = 512;
 
+  static bool renderBefore(const GameObject* a, const GameObject* b) {
+    if (a->m_sceneZ != b->m_sceneZ) return a->m_sceneZ < b->m_sceneZ;
+    return a->m_sceneSeq < b->m_sceneSeq;
+  }
+
+  void adopt(GameObject* o) {
+    o->m_sceneSeq = m_nextSeq++;
+    o->m_sceneZ = o->zIndex();
+    o->m_zDirty = false;
+    o->m_dead = false;
+    // Appending keeps the order sorted unless o belongs further forward.
+    if (!m_renderOrder.empty() && renderBefore(o, m_renderOrder.back()))
+      m_orderDirty = true;
+    m_objects.push_back(o);
+    m_renderOrder.push_back(o);
+  }
 
+  ObjectPool& poolFor(std::size_t size) {
+    const std::size_t cls = (size + kPoolGranularity - 1) / kPoolGranularity;
+    if (cls >= m_pools.size()) m_pools.resize(cls + 1);
+    if (!m_pools[cls])
+      m_pools[cls] = std::make_unique<ObjectPool>(cls * kPoolGranularity);
+    return *m_pools[cls];
+  }
+
+  static void destroy(GameObject* o) {
+    ObjectPool* pool = o->m_pool;
+    if (!pool) {
+      delete o;
+      return;
+    }
+    void* mem = dynamic_cast<void*>(o); // most-derived object = pool block
+    o->~GameObject();
+    pool->deallocate(mem);
+  }
+
+  // Drops dead objects from both arrays in one stable pass each, so neither
+  // the update order nor the render order needs re-sorting.
+  void compact() {
+    auto isDead = [](const GameObject* o) { return o->m_dead; };
+    m_renderOrder.erase(
+        std::remove_if(m_renderOrder.begin(), m_renderOrder.end(), isDead),
+        m_renderOrder.end());
+    std::size_t keep = 0;
+    for (GameObject* o : m_objects) {
+      if (o->m_dead)
+        destroy(o);
+      else
+        m_objects[keep++] = o;
+    }
+    m_objects.resize(keep);
+    m_deadCount = 0;
+  }
+
+  // Pools are declared first so they outlive the objects placed in them.
+  std::vector<std::unique_ptr<ObjectPool>> m_pools;
+  std::vector<GameObject*> m_objects;     // owning; insertion order
+  std::vector<GameObject*> m_renderOrder; // same objects, by (z, insertion)
+  std::uint64_t m_nextSeq = 0;
+  std::size_t m_deadCount = 0;
+  bool m_orderDirty = false;
+
+  World m_world;
+  std::vector<std::unique_ptr<System>> m_systems;
+  std::vector<System*> m_systemRenderOrder; // by zIndex(), stable
+  EventBus<SDL_Event> m_events;
+};
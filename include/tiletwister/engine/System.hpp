@@ -0,0 +1,74 @@
+#pragma once
+
+#include <tiletwister/engine/World.hpp>
+
+#include <cstdint>
+#include <vector>
+
+struct SDL_Rect;
+struct SDL_Renderer;
+
+// A pass over World component arrays, hosted by Scene next to GameObjects.
+// Systems update in the order they were added (after the GameObjects) and
+// render interleaved with GameObjects by zIndex().
+class System {
+public:
+  virtual ~System() = default;
+
+  virtual void update(World&, float /*dtSec*/) {}
+  virtual void render(World&, SDL_Renderer*) {}
+  virtual int zIndex() const { return 0; }
+};
+
+// Advances every tween in one TweenPool pass, then writes the values into
+// the Transforms in one linear walk over the tween components.
+class TweenSystem final : public System {
+public:
+  void update(World& world, float dtSec) override {
+    world.tweenPool().update(dtSec);
+
+    ComponentArray<TweenComponent>& tweens = world.tweens();
+    ComponentArray<Transform>& transforms = world.transforms();
+    m_finished.clear();
+    // Backwards: removing index i only moves an already-visited component.
+    for (std::size_t i = tweens.size(); i-- > 0;) {
+      const TweenComponent& c = tweens.data()[i];
+      const std::uint32_t entity = tweens.entityAt(i);
+      float v0 = c.end0;
+      float v1 = c.end1;
+      const bool running = world.tweenPool().value(c.handle, v0, v1);
+      if (Transform* t = transforms.find(entity)) {
+        if (c.target == TweenComponent::Target::Position) {
+          t->x = v0;
+          t->y = v1;
+        } else {
+          t->scale = v0;
+        }
+      }
+      if (running) continue;
+      if (c.destroyOnFinish)
+        m_finished.push_back(entity);
+      tweens.remove(entity);
+    }
+    for (std::uint32_t entity : m_finished)
+      world.destroy(world.entityAt(entity));
+  }
+
+private:
+  std::vector<std::uint32_t> m_finished; // reused; no per-frame allocation
+};
+
+// Draws every Sprite that has a Transform as a filled rect, ordered by layer.
+// Runs of same-colored sprites go out as one SDL_RenderFillRects call.
+class SpriteRenderSystem final : public System {
+public:
+  explicit SpriteRenderSystem(int zIndex = 0);
+  ~SpriteRenderSystem() override;
+
+  void render(World& world, SDL_Renderer* renderer) override;
+  int zIndex() const override { return m_zIndex; }
+
+private:
+  int m_zIndex;
+  std::vector<SDL_Rect> m_batch; // reused across frames
+};
@@ -0,0 +1,157 @@
+#pragma once
+
+#include <tiletwister/core/Tween.hpp>
+#include <tiletwister/engine/ComponentArray.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Data-oriented entity storage: an entity is just an index + generation, and
+// each component type lives in its own contiguous ComponentArray that systems
+// walk linearly. Meant for large numbers of simple things (effects, tiles of
+// extra boards); one-off logic can stay a GameObject.
+
+struct Entity {
+  std::uint32_t index = ~0u;
+  std::uint32_t generation = 0;
+};
+
+// Axis-aligned box in window pixels; scale is applied around its center.
+struct Transform {
+  float x = 0.0f;
+  float y = 0.0f;
+  float w = 0.0f;
+  float h = 0.0f;
+  float scale = 1.0f;
+};
+
+struct Sprite {
+  std::uint8_t r = 255;
+  std::uint8_t g = 255;
+  std::uint8_t b = 255;
+  std::uint8_t a = 255;
+  int layer = 0; // draw order within the sprite system
+};
+
+// A running TweenPool tween that drives the entity's Transform.
+struct TweenComponent {
+  enum class Target : std::uint8_t { Position, Scale };
+
+  TweenHandle handle;
+  float end0 = 0.0f; // value applied once the tween retires
+  float end1 = 0.0f;
+  Target target = Target::Position;
+  bool destroyOnFinish = false; // destroy the entity when the tween ends
+};
+
+class World {
+public:
+  Entity create() {
+    std::uint32_t index;
+    if (!m_freeIndices.empty()) {
+      index = m_freeIndices.back();
+      m_freeIndices.pop_back();
+    } else {
+      index = static_cast<std::uint32_t>(m_generations.size());
+      m_generations.push_back(0);
+    }
+    ++m_alive;
+    return Entity{index, m_generations[index]};
+  }
+
+  // Removes the entity's components; handles to it become stale.
+  void destroy(Entity e) {
+    if (!alive(e)) return;
+    if (TweenComponent* t = m_tweens.find(e.index)) m_tweenPool.stop(t->handle);
+    m_transforms.remove(e.index);
+    m_sprites.remove(e.index);
+    m_tweens.remove(e.index);
+    ++m_generations[e.index];
+    m_freeIndices.push_back(e.index);
+    --m_alive;
+  }
+
+  // Current handle for a live entity index (e.g. from ComponentArray).
+  Entity entityAt(std::uint32_t index) const {
+    return Entity{index, m_generations[index]};
+  }
+
+  bool alive(Entity e) const {
+    return e.index < m_generations.size() &&
+           m_generations[e.index] == e.generation;
+  }
+
+  std::size_t size() const { return m_alive; }
+
+  void clear() {
+    m_transforms.clear();
+    m_sprites.clear();
+    m_tweens.clear();
+    m_tweenPool.clear();
+    for (std::uint32_t& g : m_generations) ++g;
+    m_freeIndices.clear();
+    for (std::uint32_t i = static_cast<std::uint32_t>(m_generations.size());
+         i-- > 0;)
+      m_freeIndices.push_back(i);
+    m_alive = 0;
+    m_spritesUnsorted = false;
+  }
+
+  ComponentArray<Transform>& transforms() { return m_transforms; }
+  ComponentArray<TweenComponent>& tweens() { return m_tweens; }
+  ComponentArray<Sprite>& sprites() { return m_sprites; }
+  TweenPool& tweenPool() { return m_tweenPool; }
+
+  Transform& addTransform(Entity e, const Transform& t) {
+    return m_transforms.add(e.index, t);
+  }
+
+  Sprite& addSprite(Entity e, const Sprite& s) {
+    if (m_sprites.size() > 0 &&
+        s.layer < m_sprites.data()[m_sprites.size() - 1].layer)
+      m_spritesUnsorted = true;
+    return m_sprites.add(e.index, s);
+  }
+
+  // Call after changing a Sprite's layer in place.
+  void spriteLayersChanged() { m_spritesUnsorted = true; }
+
+  // Sorts sprites by layer if an add or layer change broke the order.
+  void sortSpritesIfNeeded() {
+    if (!m_spritesUnsorted) return;
+    m_sprites.sort(
+        [](const Sprite& a, const Sprite& b) { return a.layer < b.layer; });
+    m_spritesUnsorted = false;
+  }
+
+  // Tweens the entity's position (or scale, in the first channel) from its
+  // current Transform. Requires a Transform; replaces a running tween.
+  void tweenTo(Entity e, TweenComponent::Target target, float to0, float to1,
+               float durationSec, Easing easing, bool destroyOnFinish = false) {
+    const Transform& t = m_transforms.get(e.index);
+    const bool pos = target == TweenComponent::Target::Position;
+    if (TweenComponent* old = m_tweens.find(e.index))
+      m_tweenPool.stop(old->handle);
+    const float from0 = pos ? t.x : t.scale;
+    const float from1 = pos ? t.y : 0.0f;
+    const TweenHandle h =
+        m_tweenPool.start(from0, from1, to0, to1, durationSec, easing);
+    // Pulse returns to where it started.
+    const bool back = easing == Easing::Pulse;
+    m_tweens.add(e.index, TweenComponent{h, back ? from0 : to0,
+                                         back ? from1 : to1, target,
+                                         destroyOnFinish});
+  }
+
+private:
+  std::vector<std::uint32_t> m_generations;
+  std::vector<std::uint32_t> m_freeIndices;
+  std::size_t m_alive = 0;
+
+  ComponentArray<Transform> m_transforms;
+  ComponentArray<Sprite> m_sprites;
+  ComponentArray<TweenComponent> m_tweens;
+  TweenPool m_tweenPool{256};
+  bool m_spritesUnsorted = false;
+};
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <tiletwister/game/Game.hpp>
+
+#include <cstdint>
+
+// Packed 4x4 board for search: 16 nibbles holding tile exponents (0 = empty,
+// 1 = 2, ... 15 = 32768), row r in bits [16r, 16r + 16), cell (r, c) in
+// nibble 4r + c. Moves use precomputed per-row tables (built once, ~400 KB),
+// so a move is four lookups instead of a scan of the grid.
+using Bitboard = std::uint64_t;
+
+namespace Bitboards {
+
+// Tiles above 32768 are clamped to 32768 (search-only approximation).
+Bitboard fromGrid(const int grid[4][4]);
+void toGrid(Bitboard b, int grid[4][4]);
+
+inline int exponentAt(Bitboard b, int r, int c) {
+  return static_cast<int>((b >> (4 * (4 * r + c))) & 0xF);
+}
+inline Bitboard withExponent(Bitboard b, int r, int c, int e) {
+  const int shift = 4 * (4 * r + c);
+  return (b & ~(Bitboard{0xF} << shift)) |
+         (static_cast<Bitboard>(e) << shift);
+}
+
+int countEmpty(Bitboard b);
+
+// Same rules as Game::tryMove (each tile merges at most once). Returns the
+// board after the move (== b if nothing moved) and adds merged values to
+// *scoreGained when given.
+Bitboard move(Bitboard b, Direction dir, int* scoreGained = nullptr);
+
+// Static evaluation used by the search: rewards empty cells, monotonic rows
+// and columns and adjacent equal tiles. Larger is better.
+float heuristic(Bitboard b);
+
+} // namespace Bitboards
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <tiletwister/game/Bitboard.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+
+struct SearchLimits {
+  std::chrono::steady_clock::time_point deadline =
+      std::chrono::steady_clock::time_point::max();
+  int maxDepth = 6; // moves looked ahead (chance nodes in between)
+  // Polled during the search; true aborts it (result.cancelled).
+  const std::atomic<bool>* cancel = nullptr;
+};
+
+struct SearchResult {
+  bool found = false;     // false: no legal move, or stopped before depth 1
+  bool cancelled = false; // stopped through SearchLimits::cancel
+  Direction dir = Direction::Left;
+  int depth = 0;          // deepest fully searched depth
+  std::uint64_t nodes = 0;
+};
+
+// Iterative-deepening expectimax over Bitboards: max nodes try the four
+// moves, chance nodes average over every empty cell (2 at 90%, 4 at 10%),
+// leaves use Bitboards::heuristic. Each completed depth replaces the answer,
+// so running out of time returns the best move of the last full depth.
+// Unlikely branches are cut, and a per-depth transposition table avoids
+// re-searching boards reached by different move orders. Allocates a fresh
+// table per call; repeated searches should go through an ExpectimaxSearcher.
+SearchResult searchBestMove(Bitboard board, const SearchLimits& limits);
+
+// Search state reused across calls: the transposition table (~1 MB) is
+// allocated once instead of per search, and its entries (keyed by board and
+// remaining depth) stay valid from one search to the next. One thread at a
+// time.
+class ExpectimaxSearcher {
+public:
+  ExpectimaxSearcher();
+  ~ExpectimaxSearcher();
+
+  ExpectimaxSearcher(const ExpectimaxSearcher&) = delete;
+  ExpectimaxSearcher& operator=(const ExpectimaxSearcher&) = delete;
+
+  SearchResult search(Bitboard board, const SearchLimits& limits);
+
+private:
+  struct Table;
+  std::unique_ptr<Table> m_table;
+};
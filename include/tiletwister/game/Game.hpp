@@ -1,8 +1,11 @@
 #pragma once
 
+#include <tiletwister/core/InlineVector.hpp>
+#include <tiletwister/core/Rng.hpp>
+
+#include <cstdint>
 #include <optional>
 #include <utility>
-#include <vector>
 
 enum class Direction { Left, Right, Up, Down };
 
@@ -18,21 +21,39 @@ struct MoveAnim {
   int value = 0;
 };
 
+// Fixed capacity (no allocation per move): every tile slides at most once
+// and a 4x4 board has at most 8 merges.
 struct MoveResult {
   bool moved = false;
-  std::vector<MoveAnim> animations;     // tiles that visually slide
-  std::vector<Cell> mergedCells;        // destination cells that merged (pop)
+  InlineVector<MoveAnim, 16> animations; // tiles that visually slide
+  InlineVector<Cell, 8> mergedCells;     // destination cells that merged (pop)
   std::optional<std::pair<Cell, int>> pendingSpawn; // apply after slide ends
 };
 
+// Everything needed to resume a game exactly (including future spawns).
+struct GameState {
+  int grid[4][4]{};
+  int score = 0;
+  std::optional<std::pair<Cell, int>> pendingSpawn;
+  std::uint64_t rngState = 0;
+  std::uint64_t seed = 0; // rng state when the game started
+  std::uint32_t moveCount = 0;
+  // Time played in earlier sessions; saved and restored by the caller, Game
+  // doesn't track it.
+  std::uint32_t playedMs = 0;
+};
+
 class Game {
 public:
+  // Seeds the game's own Rng from Utils::rng().
   Game();
+  explicit Game(std::uint64_t seed);
 
   void reset();
 
   // Returns the move result; when moved==true the internal grid is updated
   // to the post-merge state (but before spawning the new tile).
+  // A spawn still pending from the previous move is committed first.
   MoveResult tryMove(Direction dir);
 
   // Call after finishing move animation to actually spawn the pending tile.
@@ -42,6 +63,11 @@ public:
   bool isGameOver() const;
 
   int score() const { return m_score; }
+  std::uint32_t moveCount() const { return m_moveCount; }
+  std::uint64_t seed() const { return m_seed; }
+
+  GameState state() const;
+  void restore(const GameState& st);
 
   const int (&grid() const)[4][4] { return m_grid; }
 
@@ -53,10 +79,13 @@ private:
   int m_grid[4][4]{};
   std::optional<std::pair<Cell, int>> m_pendingSpawn;
   int m_score = 0;
+  Rng m_rng;
+  std::uint64_t m_seed = 0;
+  std::uint32_t m_moveCount = 0;
 
   void clearGrid();
   void spawnInitial();
-  std::optional<std::pair<Cell, int>> rollSpawn(const int grid[4][4]) const;
+  std::optional<std::pair<Cell, int>> rollSpawn(const int grid[4][4]);
 
   bool hasAnyMove(const int grid[4][4]) const;
 };
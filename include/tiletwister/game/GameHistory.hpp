@@ -0,0 +1,117 @@
+#pragma once
+
+#include <tiletwister/core/AsyncFileWriter.hpp>
+#include <tiletwister/core/MappedFile.hpp>
+
+#include <array>
+#include <cstdint>
+#include <string>
+
+// Append-only history of finished games.
+//
+// <path>      16-byte header + fixed 32-byte GameRecords, append-only.
+// <path>.idx  16-byte header + one HistoryBlockSummary per complete block of
+//             kHistoryBlockRecords records (max score, score sum, max-tile
+//             and score histograms), so queries over many games touch one
+//             summary per block instead of every record.
+// Both are read through a memory mapping; no text parsing anywhere. Fields are
+// stored in host byte order (little-endian on every supported target).
+
+constexpr std::uint32_t kHistoryVersion = 1;
+constexpr std::uint32_t kHistoryIndexVersion = 2; // 2: score histogram
+constexpr std::uint32_t kHistoryBlockRecords = 4096;
+constexpr int kHistoryTileBuckets = 18; // log2(max tile): 0 .. 17
+// Scores 0..15 exactly, then 16 buckets per power of two (at most 6.25%
+// wide) up to INT32_MAX; see historyScoreBucket().
+constexpr int kHistoryScoreBuckets = 448;
+
+struct GameRecord {
+  std::int64_t finishedAtMs; // Unix time
+  std::uint64_t seed;
+  std::int32_t score;
+  std::int32_t maxTile;
+  std::uint32_t moveCount;
+  std::uint32_t durationMs;
+};
+static_assert(sizeof(GameRecord) == 32, "GameRecord layout changed");
+
+struct HistoryFileHeader {
+  char magic[4]; // "TTGH" (log) / "TTGI" (index)
+  std::uint32_t version;
+  std::uint32_t entrySize;
+  std::uint32_t blockRecords;
+};
+static_assert(sizeof(HistoryFileHeader) == 16,
+              "HistoryFileHeader layout changed");
+
+struct HistoryBlockSummary {
+  std::uint32_t count;
+  std::int32_t maxScore;
+  std::uint64_t scoreSum;
+  std::uint32_t maxTileHist[kHistoryTileBuckets];
+  std::uint32_t reserved[2];
+  std::uint16_t scoreHist[kHistoryScoreBuckets]; // a block fits in 16 bits
+};
+static_assert(sizeof(HistoryBlockSummary) == 992,
+              "HistoryBlockSummary layout changed");
+
+// Log-scaled bucket of a score (negative scores count as 0), monotonic.
+int historyScoreBucket(std::int32_t score);
+
+// Adds one record to a running summary.
+void accumulate(HistoryBlockSummary& s, const GameRecord& rec);
+
+// Appends records from the game thread. All file writes go through the
+// AsyncFileWriter; open() does a one-time synchronous check at startup
+// (drops a torn trailing record, rebuilds a missing/stale index).
+class GameHistoryWriter {
+public:
+  GameHistoryWriter(std::string path, AsyncFileWriter& io);
+
+  void open();
+  void append(const GameRecord& rec);
+
+  std::uint64_t size() const { return m_count; }
+
+private:
+  std::string m_path;
+  std::string m_indexPath;
+  AsyncFileWriter& m_io;
+  bool m_opened = false;
+  bool m_logHasHeader = false;
+  std::uint64_t m_count = 0;
+  std::uint64_t m_indexBlocks = 0;
+  HistoryBlockSummary m_block{}; // current (incomplete) block
+};
+
+// Read-only queries over a memory-mapped history.
+class GameHistory {
+public:
+  bool open(const std::string& path);
+
+  std::uint64_t size() const { return m_count; }
+  GameRecord record(std::uint64_t i) const;
+
+  // Best score among the last n games (0 if empty).
+  int bestOfLast(std::uint64_t n) const;
+  // Score at percentile p in [0, 100] (nearest rank), 0 if empty. Finds the
+  // score bucket from the block summaries, then reads only the blocks that
+  // hold games in that bucket.
+  int scorePercentile(double p) const;
+  double averageScore() const;
+  // Games per log2(max tile).
+  std::array<std::uint64_t, kHistoryTileBuckets> maxTileHistogram() const;
+
+private:
+  MappedFile m_log;
+  MappedFile m_index;
+  const GameRecord* m_records = nullptr;
+  std::uint64_t m_count = 0;
+  const HistoryBlockSummary* m_blocks = nullptr;
+  std::uint64_t m_indexBlocks = 0; // usable index entries
+
+  HistoryBlockSummary blockSummary(std::uint64_t block) const;
+  HistoryBlockSummary summarize(std::uint64_t begin, std::uint64_t end) const;
+  // Percentile by copying every score; only if the summaries are wrong.
+  int scanPercentile(std::uint64_t rank) const;
+};
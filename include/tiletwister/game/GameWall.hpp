@@ -0,0 +1,83 @@
+#pragma once
+
+#include <tiletwister/game/Bitboard.hpp>
+#include <tiletwister/game/Game.hpp>
+#include <tiletwister/game/MovePolicy.hpp>
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Every board of a wall at one point in time, packed (see Bitboard).
+struct WallSnapshot {
+  static constexpr int kMaxBoards = 1024;
+
+  std::array<Bitboard, kMaxBoards> boards{};
+  int boardCount = 0;
+};
+
+// Many independent autoplaying games ("wall" view).
+//
+// Boards are split into contiguous slices, one per worker thread; each worker
+// steps its slice at a fixed rate with its own MovePolicy and publishes every
+// board as one relaxed 64-bit store. The games don't interact, so a reader
+// needs no more consistency than that: snapshot() never waits for a worker.
+// Finished games stay up for kRestartSec, then start over.
+class GameWall {
+public:
+  static constexpr double kStepSec = 1.0 / 60.0;
+  static constexpr float kRestartSec = 2.0f;
+
+  // workers <= 0 picks one per hardware thread (leaving one for rendering).
+  // Unknown policy names fall back to expectimax.
+  GameWall(int boards, int workers, const std::string& policy,
+           int movesPerSec, std::uint64_t seed);
+  ~GameWall(); // stops the workers
+
+  GameWall(const GameWall&) = delete;
+  GameWall& operator=(const GameWall&) = delete;
+
+  void start();
+  void stop();
+
+  // Any thread.
+  void snapshot(WallSnapshot& out) const;
+  int boardCount() const { return static_cast<int>(m_games.size()); }
+  int workerCount() const { return static_cast<int>(m_workers.size()); }
+  std::uint64_t moves() const;
+  std::uint64_t gamesFinished() const;
+
+  // Steps one worker's slice by dtSec on the calling thread (tests; not
+  // while started).
+  void stepWorker(int worker, float dtSec);
+
+private:
+  struct Board {
+    Game game;
+    float credit = 0.0f;      // moves owed at m_movesPerSec
+    float gameOverSec = 0.0f; // time the final board has been shown
+  };
+
+  // One per thread, on its own cache line: counters are bumped every step.
+  struct alignas(64) Worker {
+    int first = 0; // boards [first, last)
+    int last = 0;
+    std::unique_ptr<MovePolicy> policy;
+    std::atomic<std::uint64_t> moves{0};
+    std::atomic<std::uint64_t> games{0};
+  };
+
+  int m_movesPerSec;
+  std::vector<Board> m_games;
+  std::unique_ptr<std::atomic<Bitboard>[]> m_boards; // published per board
+  std::vector<std::unique_ptr<Worker>> m_workers;
+  std::vector<std::thread> m_threads;
+  std::atomic<bool> m_running{false};
+
+  void run(int worker);
+  void publish(int board);
+};
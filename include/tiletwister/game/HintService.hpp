@@ -0,0 +1,57 @@
+#pragma once
+
+#include <tiletwister/game/Expectimax.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+// Best-move search on a background thread.
+//
+// request() and cancel() only store into atomics (plus a notify), and poll()
+// is a single atomic load, so the caller never waits for a search. A new
+// request or cancel() aborts the search in flight; its result is never
+// delivered. Each search is bounded by the time budget.
+class HintService {
+public:
+  struct Hint {
+    std::uint32_t request = 0; // id returned by request()
+    Direction dir = Direction::Left;
+    int depth = 0;
+  };
+
+  explicit HintService(int budgetMs = 150, int maxDepth = 6);
+  ~HintService();
+
+  HintService(const HintService&) = delete;
+  HintService& operator=(const HintService&) = delete;
+
+  // Starts searching grid, replacing any earlier request. Returns its id.
+  std::uint32_t request(const int grid[4][4]);
+  // Drops the current request.
+  void cancel();
+  // True once the result for the current request is ready (a board without
+  // legal moves never gets one).
+  bool poll(Hint& out) const;
+
+private:
+  int m_budgetMs;
+  int m_maxDepth;
+
+  // Request mailbox: the board is stored before the id is published.
+  std::atomic<Bitboard> m_board{0}; // 0 = nothing to search
+  std::atomic<std::uint32_t> m_requestId{0};
+  std::atomic<bool> m_abort{false}; // aborts the search in flight
+  // Result mailbox: request id << 32 | depth << 8 | direction.
+  std::atomic<std::uint64_t> m_result{0};
+
+  std::mutex m_mutex; // only for sleeping/waking the worker
+  std::condition_variable m_wake;
+  bool m_stop = false;
+  std::thread m_thread;
+
+  std::uint32_t publishRequest(Bitboard board);
+  void run();
+};
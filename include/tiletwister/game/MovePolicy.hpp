@@ -0,0 +1,53 @@
+#pragma once
+
+#include <tiletwister/core/Rng.hpp>
+#include <tiletwister/game/Expectimax.hpp>
+#include <tiletwister/game/Game.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+// Picks moves for autoplay. Called on the simulation thread with the settled
+// board (no spawn pending), possibly thousands of times per second, so
+// implementations should be cheap and must not allocate per call.
+class MovePolicy {
+public:
+  virtual ~MovePolicy() = default;
+
+  // Stores a legal move in out; false if the policy has none to offer.
+  virtual bool chooseMove(const int grid[4][4], Direction& out) = 0;
+};
+
+// A uniformly random legal move.
+class RandomPolicy final : public MovePolicy {
+public:
+  explicit RandomPolicy(std::uint64_t seed) : m_rng(seed) {}
+  bool chooseMove(const int grid[4][4], Direction& out) override;
+
+private:
+  Rng m_rng;
+};
+
+// The first legal move of Down, Left, Right, Up: keeps big tiles in the
+// bottom-left corner. Nearly free.
+class CornerPolicy final : public MovePolicy {
+public:
+  bool chooseMove(const int grid[4][4], Direction& out) override;
+};
+
+// Fixed-depth expectimax without a deadline, so the speed of play doesn't
+// change its moves. The search table is allocated once, with the policy.
+class ExpectimaxPolicy final : public MovePolicy {
+public:
+  explicit ExpectimaxPolicy(int maxDepth = 2) : m_maxDepth(maxDepth) {}
+  bool chooseMove(const int grid[4][4], Direction& out) override;
+
+private:
+  int m_maxDepth;
+  ExpectimaxSearcher m_searcher;
+};
+
+// "random", "corner" or "expectimax"; nullptr for any other name.
+std::unique_ptr<MovePolicy> makeMovePolicy(const std::string& name,
+                                           std::uint64_t seed);
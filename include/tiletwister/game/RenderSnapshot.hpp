@@ -0,0 +1,44 @@
+#pragma once
+
+#include <tiletwister/game/TileStore.hpp>
+
+#include <array>
+#include <cstdint>
+
+// One visual tile at the last two simulation steps; the renderer blends
+// between them (alpha 0 = previous step, 1 = latest).
+struct TileSnapshot {
+  int value = 0;
+  int exponent = 0;
+  float row0 = 0.0f, col0 = 0.0f, scale0 = 1.0f; // previous step
+  float row1 = 0.0f, col1 = 0.0f, scale1 = 1.0f; // latest step
+};
+
+// Everything the renderer needs for a frame, copied out of the simulation so
+// it can be drawn on another thread. Fixed size and trivially copyable: no
+// pointers into simulation state, no allocation.
+struct RenderSnapshot {
+  std::array<TileSnapshot, TileStore::kCapacity> tiles{};
+  int tileCount = 0; // tiles[0, tileCount) in draw order (ascending value)
+  int score = 0;
+  int bestScore = 0;
+  bool gameOver = false;
+  bool hintShown = false;   // draw an arrow for hintDir
+  bool hintPending = false; // a hint search is running
+  Direction hintDir = Direction::Left;
+  int autoplayMovesPerSec = -1; // -1: autoplay off
+
+  std::uint64_t step = 0;      // simulation step that produced it
+  std::int64_t publishedNs = 0; // steady_clock time it was published
+  float stepSec = 0.0f;         // simulation step length
+
+  // Latest move started (counts up per move) and when the key press that
+  // caused it was polled (0: key repeat or no input), for latency tracking.
+  std::uint32_t moveSeq = 0;
+  std::int64_t moveInputNs = 0;
+};
+
+// Copies the visual tiles (positions/scales at the previous and latest
+// update) into out, sorted so larger tiles draw on top. HUD fields and
+// timing are left to the caller.
+void captureTiles(const TileStore& tiles, RenderSnapshot& out);
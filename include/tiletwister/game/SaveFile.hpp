@@ -0,0 +1,39 @@
+#pragma once
+
+#include <tiletwister/game/Game.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Binary game save: one fixed-layout record, written with a single write and
+// read back with a single read (no parsing). Fields are stored in host byte
+// order (little-endian on every supported target).
+struct SaveRecord {
+  char magic[4];               // "TTSV"
+  std::uint32_t version;       // kSaveVersion
+  std::int32_t grid[16];       // row-major
+  std::int32_t score;
+  std::int32_t spawnCell;      // r * 4 + c, or -1 when no spawn is pending
+  std::int32_t spawnValue;
+  std::uint32_t moveCount;
+  std::uint64_t rngState;
+  std::uint64_t seed;
+  std::uint32_t checksum;      // FNV-1a over every other byte
+  std::uint32_t playedMs;      // version 1: reserved, always 0
+};
+static_assert(sizeof(SaveRecord) == 112, "SaveRecord layout changed");
+
+// 2: playedMs (version 1 saves still load, with playedMs 0).
+constexpr std::uint32_t kSaveVersion = 2;
+
+SaveRecord encodeSave(const GameState& st);
+
+// Validates magic/version/checksum and field ranges.
+bool decodeSave(const SaveRecord& rec, GameState& out);
+
+// Record bytes, ready for AsyncFileWriter::submit.
+std::string saveBytes(const GameState& st);
+
+// Reads and decodes path. Returns false if missing, truncated or invalid.
+bool loadSaveFile(const std::string& path, GameState& out);
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <tiletwister/core/Rng.hpp>
+#include <tiletwister/game/Bitboard.hpp>
+
+#include <cstdint>
+#include <vector>
+
+// One game of the session server, packed into 32 bytes.
+struct Session {
+  Bitboard board = 0;
+  std::uint64_t rng = 0; // Rng state: spawns continue from here
+  std::uint32_t score = 0;
+  std::uint32_t moves = 0;
+  std::uint32_t owner = 0;    // connection that created it
+  std::uint8_t generation = 0; // bumped each time the slot is reused
+  bool live = false;
+  bool over = false; // no legal move left
+};
+
+// Sessions for many concurrent players, in one contiguous array.
+//
+// Slots are preallocated and recycled through a free list, so creating,
+// playing and closing games never allocates. Ids carry the slot's generation
+// and go stale once their session is destroyed. A session plays exactly like
+// Game(seed): same spawns, scores and move counts for the same moves. The
+// only difference is the Bitboard limit: tiles stop merging at 32768.
+class SessionPool {
+public:
+  static constexpr std::uint32_t kInvalid = 0;
+  static constexpr std::uint32_t kMaxCapacity = 1u << 24;
+
+  // slots is clamped to [1, kMaxCapacity]; seed feeds the seeds of games
+  // created with seed 0.
+  explicit SessionPool(std::uint32_t slots, std::uint64_t seed = 0);
+
+  // Starts a game; kInvalid when the pool is full.
+  std::uint32_t create(std::uint64_t seed, std::uint32_t owner);
+  bool destroy(std::uint32_t id);
+  // nullptr for unknown or stale ids.
+  Session* find(std::uint32_t id);
+
+  // Slides, merges and spawns like Game::tryMove + commitPendingSpawn.
+  // Returns false (session unchanged) if dir doesn't move anything.
+  static bool move(Session& s, Direction dir);
+
+  std::uint32_t live() const { return m_live; }
+  std::uint32_t capacity() const {
+    return static_cast<std::uint32_t>(m_sessions.size());
+  }
+
+private:
+  std::vector<Session> m_sessions;
+  std::vector<std::uint32_t> m_free; // slot indices, reused LIFO
+  std::uint32_t m_live = 0;
+  Rng m_seeds;
+};
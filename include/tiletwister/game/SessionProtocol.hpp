@@ -0,0 +1,69 @@
+#pragma once
+
+#include <tiletwister/game/SessionPool.hpp>
+
+#include <cstddef>
+#include <cstdint>
+
+// Wire format of the session server: fixed-size little-endian records, so a
+// stream is parsed by slicing it and requests can be pipelined freely. Every
+// request gets exactly one response, in order.
+//
+// Request (8 bytes):
+//   [0] op  [1] direction (Move: 0 left, 1 right, 2 up, 3 down)  [2..3] 0
+//   [4..7] session id (NewGame: seed, 0 = server's choice)
+// Response (24 bytes):
+//   [0] status  [1] op  [2] flags (bit 0 moved, bit 1 game over)  [3] 0
+//   [4..7] session id  [8..15] board (Bitboard nibbles)  [16..19] score
+//   [20..23] moves
+namespace SessionProtocol {
+
+constexpr std::size_t kRequestSize = 8;
+constexpr std::size_t kResponseSize = 24;
+
+enum class Op : std::uint8_t {
+  NewGame = 1, // starts a game owned by this connection
+  Move = 2,    // plays one move and returns the new state
+  State = 3,   // returns the state without changing it
+  Close = 4,   // ends the game (also done when the connection closes)
+};
+
+enum class Status : std::uint8_t {
+  Ok = 0,
+  UnknownSession = 1, // stale, never existed or owned by another connection
+  PoolFull = 2,
+  BadRequest = 3,
+};
+
+constexpr std::uint8_t kFlagMoved = 1;
+constexpr std::uint8_t kFlagGameOver = 2;
+
+struct Request {
+  Op op = Op::State;
+  Direction dir = Direction::Left;
+  std::uint32_t session = 0; // NewGame: seed
+};
+
+struct Response {
+  Status status = Status::Ok;
+  Op op = Op::State;
+  std::uint8_t flags = 0;
+  std::uint32_t session = 0;
+  Bitboard board = 0;
+  std::uint32_t score = 0;
+  std::uint32_t moves = 0;
+};
+
+void encodeRequest(const Request& req, std::uint8_t* out);
+// False for an unknown op or direction.
+bool decodeRequest(const std::uint8_t* in, Request& out);
+void encodeResponse(const Response& resp, std::uint8_t* out);
+void decodeResponse(const std::uint8_t* in, Response& out);
+
+// Serves one request for connection owner: reads kRequestSize bytes from in,
+// writes kResponseSize bytes to out. New games are recorded as owned by
+// owner; sessions of other owners are reported as unknown.
+Response handleRequest(SessionPool& pool, std::uint32_t owner,
+                       const std::uint8_t* in, std::uint8_t* out);
+
+} // namespace SessionProtocol
@@ -1,53 +1,50 @@
 #pragma once
 
+#include <tiletwister/core/Tween.hpp>
+#include <tiletwister/core/Utils.hpp>
 #include <tiletwister/game/Game.hpp>
 
-struct TileAnim {
-  bool active = false;
-  float t = 1.0f;         // 0..1
-  float duration = 0.12f; // seconds
-  Cell from{0, 0};
-  Cell to{0, 0};
-};
-
-struct PopAnim {
-  bool active = false;
-  float t = 1.0f;         // 0..1
-  float duration = 0.10f; // seconds
-};
-
+// One visual tile. Slide/pop state lives in a TweenPool (shared by all tiles
+// of a board, advanced in one batched pass); the tile only keeps handles.
 class Tile {
 public:
   Tile() = default;
   Tile(int value, Cell cell);
 
-  void setValue(int v) { m_value = v; }
+  void setValue(int v) {
+    m_value = v;
+    m_exponent = Utils::tileExponent(v);
+  }
   int value() const { return m_value; }
+  // log2(value), cached so color lookups are a direct table index.
+  int exponent() const { return m_exponent; }
 
   void setCell(Cell c) { m_cell = c; }
   Cell cell() const { return m_cell; }
 
   // Animation controls
-  void startSlide(Cell from, Cell to, float durationSec);
-  void startPop(float durationSec);
-  void update(float dtSec);
+  void startSlide(TweenPool& tweens, Cell from, Cell to, float durationSec);
+  void startPop(TweenPool& tweens, float durationSec);
+  void stopSlide(TweenPool& tweens) { tweens.stop(m_slide); }
+  void stopAnimations(TweenPool& tweens);
 
   // Visual helpers
-  bool isSliding() const { return m_slide.active; }
-  bool isPopping() const { return m_pop.active; }
+  bool isSliding(const TweenPool& tweens) const { return tweens.active(m_slide); }
+  bool isPopping(const TweenPool& tweens) const { return tweens.active(m_pop); }
 
-  // Returns interpolated grid position in continuous coordinates (row/col floats)
-  void interpolatedPos(float& outRow, float& outCol) const;
+  // Returns interpolated grid position in continuous coordinates (row/col
+  // floats). alpha blends between the last two updates (see TweenPool::sample).
+  void interpolatedPos(const TweenPool& tweens, float& outRow, float& outCol,
+                       float alpha = 1.0f) const;
 
   // Returns scale multiplier for pop effect (1.0 = normal)
-  float popScale() const;
+  float popScale(const TweenPool& tweens, float alpha = 1.0f) const;
 
 private:
   int m_value = 0;
+  int m_exponent = 0;
   Cell m_cell{0, 0}; // logical cell (where tile "ends up" in the grid)
 
-  TileAnim m_slide{};
-  PopAnim m_pop{};
+  TweenHandle m_slide{};
+  TweenHandle m_pop{};
 };
-
-
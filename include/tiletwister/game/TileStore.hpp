@@ -0,0 +1,98 @@
+#pragma once
+
+#include <tiletwister/core/Tween.hpp>
+#include <tiletwister/game/Game.hpp>
+#include <tiletwister/game/Tile.hpp>
+
+#include <array>
+#include <cstdint>
+
+// Visual tiles for one board, kept in a fixed-capacity slot array.
+//
+// - Tile ids are stable: a tile keeps its slot while it slides across moves.
+// - A per-cell index maps board cells to the tile that ends up there, so
+//   merge/spawn pops are O(1).
+// - Live ids are also kept densely packed for iteration.
+// - Slide/pop animations run in the store's TweenPool (one batched update).
+// Nothing here allocates; tiles persist across moves instead of being rebuilt.
+class TileStore {
+public:
+  // 16 board tiles + merge sources still sliding + the pending spawn.
+  static constexpr int kCapacity = 32;
+  static constexpr int kNone = -1;
+
+  TileStore() : m_tweens(2 * kCapacity) { clear(); }
+
+  void clear();
+
+  // Drops all tiles (and any pending move) and creates one per non-empty cell.
+  void syncFromGrid(const int grid[4][4]);
+
+  // Starts sliding tiles for a move returned by Game::tryMove. Merge sources
+  // stay alive (sliding into the merge cell) until finishMove.
+  void beginMove(const MoveResult& mr, float durationSec);
+
+  // Ends the move started by beginMove: snaps any unfinished slide to its
+  // destination (fast-forward), retires merged-away tiles, updates and pops
+  // merge survivors, and spawns/pops the new tile. grid is the board after
+  // Game::commitPendingSpawn. Falls back to syncFromGrid if the visual tiles
+  // disagree with the board.
+  void finishMove(const int grid[4][4]);
+
+  bool movePending() const { return m_movePending; }
+
+  void update(float dtSec) { m_tweens.update(dtSec); }
+
+  // Dense iteration over live tiles (order is unspecified).
+  int size() const { return m_liveCount; }
+  int idAt(int denseIndex) const { return m_live[denseIndex]; }
+
+  const Tile& tile(int id) const { return m_tiles[id]; }
+
+  // Per-tile animation (ids from idAt/tileAt). Positions and scales are
+  // those of the latest update; RenderSnapshot keeps the previous one too.
+  void startSlide(int id, Cell from, Cell to, float durationSec) {
+    m_tiles[id].startSlide(m_tweens, from, to, durationSec);
+  }
+  void startPop(int id, float durationSec) {
+    m_tiles[id].startPop(m_tweens, durationSec);
+  }
+  bool isSliding(int id) const { return m_tiles[id].isSliding(m_tweens); }
+  bool isPopping(int id) const { return m_tiles[id].isPopping(m_tweens); }
+  void interpolatedPos(int id, float& outRow, float& outCol) const {
+    m_tiles[id].interpolatedPos(m_tweens, outRow, outCol);
+  }
+  float popScale(int id) const {
+    return m_tiles[id].popScale(m_tweens);
+  }
+
+  const TweenPool& tweens() const { return m_tweens; }
+
+  // Tile id that occupies / is heading to the cell, or kNone.
+  int tileAt(Cell c) const { return m_cellIndex[c.r * 4 + c.c]; }
+
+  // True if every cell's tile value matches grid (and no extra tiles exist).
+  bool matchesGrid(const int grid[4][4]) const;
+
+private:
+  TweenPool m_tweens;
+  std::array<Tile, kCapacity> m_tiles{};
+  std::array<std::int8_t, kCapacity> m_live{};     // dense live ids
+  std::array<std::int8_t, kCapacity> m_densePos{}; // id -> index in m_live
+  std::array<std::int8_t, kCapacity> m_free{};     // free id stack
+  std::array<std::int8_t, 16> m_cellIndex{};       // cell -> id
+  int m_liveCount = 0;
+  int m_freeCount = 0;
+
+  // In-flight move state (beginMove -> finishMove).
+  bool m_movePending = false;
+  std::array<std::int8_t, 16> m_consumed{}; // merge sources to retire
+  int m_consumedCount = 0;
+  std::array<Cell, 16> m_pops{};            // merge destinations
+  int m_popCount = 0;
+  bool m_hasSpawn = false;
+  Cell m_spawnCell{};
+
+  int allocate(int value, Cell cell);
+  void release(int id);
+};
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+
+// Caps the frame rate by sleeping out the rest of each frame. Used when vsync
+// is off (or to run below the display rate) to keep CPU use predictable.
+//
+// SDL_Delay only has millisecond granularity, so it sleeps until shortly
+// before the deadline and yields for the last bit. Deadlines advance by a
+// fixed interval (no drift); after a long frame the schedule restarts
+// instead of rushing to catch up.
+class FramePacer {
+public:
+  explicit FramePacer(int maxFps = 0); // 0 = uncapped
+
+  void setMaxFps(int maxFps);
+  int maxFps() const { return m_maxFps; }
+
+  // Call once per frame, after presenting.
+  void wait();
+
+private:
+  int m_maxFps = 0;
+  Uint64 m_freq = 0;
+  Uint64 m_interval = 0; // counter ticks per frame
+  Uint64 m_next = 0;     // deadline of the current frame
+};
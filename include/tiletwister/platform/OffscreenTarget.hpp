@@ -0,0 +1,38 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+
+#include <string>
+
+// Headless render target: SDL's dummy video driver + a software renderer that
+// draws into an SDL_Surface. No display needed (CI, benchmarks, golden images).
+class OffscreenTarget {
+public:
+  OffscreenTarget() = default;
+  ~OffscreenTarget();
+
+  OffscreenTarget(const OffscreenTarget&) = delete;
+  OffscreenTarget& operator=(const OffscreenTarget&) = delete;
+
+  bool init(int w, int h);
+  void shutdown();
+
+  SDL_Renderer* renderer() const { return m_renderer; }
+  SDL_Surface* surface() const { return m_surface; }
+  int width() const { return m_w; }
+  int height() const { return m_h; }
+
+  // Writes the current surface contents as a BMP.
+  bool saveBMP(const std::string& path) const;
+
+  // Compares the surface against a BMP on disk. Returns the number of pixels
+  // whose channels differ by more than tolerance, or -1 if the file can't be
+  // loaded / has a different size.
+  int countDifferingPixels(const std::string& bmpPath, int tolerance) const;
+
+private:
+  SDL_Surface* m_surface = nullptr;
+  SDL_Renderer* m_renderer = nullptr;
+  int m_w = 0;
+  int m_h = 0;
+};
@@ -9,13 +9,16 @@ public:
   Window() = default;
   ~Window();
 
-  bool init(const std::string& title, int w, int h);
+  // vsync: present waits for the display's refresh.
+  bool init(const std::string& title, int w, int h, bool vsync = true);
   void shutdown();
 
   SDL_Window* sdlWindow() const { return m_window; }
   SDL_Renderer* renderer() const { return m_renderer; }
   int width() const { return m_w; }
   int height() const { return m_h; }
+  // Display refresh rate in Hz, or 0 if unknown.
+  int refreshRate() const;
 
 private:
   SDL_Window* m_window = nullptr;
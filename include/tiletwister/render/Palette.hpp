@@ -2,13 +2,72 @@
 
 #include <SDL2/SDL.h>
 
+#include <array>
+
 namespace Palette {
 
+// Highest tile exponent with its own color (2^17 = 131072, the largest tile a
+// 4x4 board can reach). Larger values clamp to it.
+constexpr int kMaxTileExponent = 17;
+
+namespace detail {
+
+constexpr SDL_Color lerpColor(SDL_Color a, SDL_Color b, int num, int den) {
+  return SDL_Color{
+      static_cast<Uint8>(a.r + (b.r - a.r) * num / den),
+      static_cast<Uint8>(a.g + (b.g - a.g) * num / den),
+      static_cast<Uint8>(a.b + (b.b - a.b) * num / den),
+      255,
+  };
+}
+
+constexpr std::array<SDL_Color, kMaxTileExponent + 1> makeTileColors() {
+  // Pleasant palette that gets more saturated as the value increases
+  // (2 .. 2048), then deepens towards purple for the rare big tiles.
+  std::array<SDL_Color, kMaxTileExponent + 1> t{};
+  t[0] = SDL_Color{0, 0, 0, 0};
+  t[1] = SDL_Color{255, 245, 250, 255};  // 2
+  t[2] = SDL_Color{255, 230, 245, 255};  // 4
+  t[3] = SDL_Color{255, 205, 235, 255};  // 8
+  t[4] = SDL_Color{255, 175, 225, 255};  // 16
+  t[5] = SDL_Color{255, 145, 215, 255};  // 32
+  t[6] = SDL_Color{255, 110, 205, 255};  // 64
+  t[7] = SDL_Color{255, 80, 190, 255};   // 128
+  t[8] = SDL_Color{250, 55, 170, 255};   // 256
+  t[9] = SDL_Color{240, 35, 150, 255};   // 512
+  t[10] = SDL_Color{225, 20, 125, 255};  // 1024
+  t[11] = SDL_Color{205, 10, 105, 255};  // 2048
+  const SDL_Color deepest{80, 15, 130, 255};
+  for (int e = 12; e <= kMaxTileExponent; ++e)
+    t[e] = lerpColor(t[11], deepest, e - 11, kMaxTileExponent - 11);
+  return t;
+}
+
+constexpr std::array<SDL_Color, kMaxTileExponent + 1> makeTileTextColors() {
+  // Dark text on light tiles (<= 8), white text on strong tiles.
+  std::array<SDL_Color, kMaxTileExponent + 1> t{};
+  for (int e = 0; e <= kMaxTileExponent; ++e)
+    t[e] = (e <= 3) ? SDL_Color{80, 40, 60, 255} : SDL_Color{255, 255, 255, 235};
+  return t;
+}
+
+} // namespace detail
+
+// Indexed by log2(value); index 0 is the (transparent) empty cell.
+inline constexpr std::array<SDL_Color, kMaxTileExponent + 1> kTileColors =
+    detail::makeTileColors();
+inline constexpr std::array<SDL_Color, kMaxTileExponent + 1> kTileTextColors =
+    detail::makeTileTextColors();
+
+// Single table load; exponent must be in [0, kMaxTileExponent].
+inline SDL_Color tileColorByExponent(int exponent) { return kTileColors[exponent]; }
+inline SDL_Color tileTextColorByExponent(int exponent) {
+  return kTileTextColors[exponent];
+}
+
 SDL_Color backgroundPink(); // RGB(255, 182, 193)
-SDL_Color tileColor(int value);
+SDL_Color tileColor(int value); // by value; clamps past 2^kMaxTileExponent
 SDL_Color tileBorderColor();
 SDL_Color gridEmptyCellColor();
 
 } // namespace Palette
-
-
@@ -1,43 +1,162 @@
 #pragma once
 
+#include <tiletwister/render/Palette.hpp>
+
 #include <SDL2/SDL.h>
 
-#include <string>
-#include <unordered_map>
+#include <array>
+#include <vector>
 
-class Game;
-class Tile;
+class FrameStats;
+class InputLatency;
+struct RenderSnapshot;
+struct WallSnapshot;
+enum class Direction;
+
+// Per-frame counters from the last Renderer::render call.
+struct RenderStats
+{
+  int drawCalls = 0;  // fills, outlines, clears and texture copies
+  int tilesDrawn = 0;
+};
 
 // Lightweight renderer:
 // - draws background, board, empty cells, tiles
 // - draws numbers using a tiny built-in 7-seg style (no SDL_ttf dependency)
+//
+// Everything that does not move (background, board base, empty cells, HUD
+// boxes + labels) is rendered once into a target texture and composited with
+// a single copy per frame. The HUD numbers live in their own small texture
+// that is only redrawn when score/best change.
 class Renderer
 {
 public:
   Renderer() = default;
-  ~Renderer() = default;
+  ~Renderer();
+
+  Renderer(const Renderer &) = delete;
+  Renderer &operator=(const Renderer &) = delete;
+
+  // Drops every cached texture. Call on SDL_RENDER_TARGETS_RESET /
+  // SDL_RENDER_DEVICE_RESET (target texture contents are lost) or before the
+  // SDL_Renderer the caches were created with is destroyed.
+  void invalidateCache();
 
   // Layout helpers (exposed so gameplay code can do hit-testing for UI).
   static SDL_Rect computeBoardRect(int windowW, int windowH);
   static SDL_Rect computeGameOverPanelRect(int windowW, int windowH);
   static SDL_Rect computeGameOverButtonRect(int windowW, int windowH);
+  // Cell (row, col) of a board placed at board, cells gap px apart.
+  static SDL_Rect computeCellRect(const SDL_Rect &board, int gap, float row,
+                                  float col);
+
+  // Wall layout: count boards in a near-square grid of equal viewports
+  // covering the window; each board is centered in its viewport.
+  static int computeWallColumns(int count, int windowW, int windowH);
+  static SDL_Rect computeWallViewport(int index, int count, int windowW,
+                                      int windowH);
+  static SDL_Rect computeViewportBoardRect(const SDL_Rect &viewport);
+
+  // Draws a simulation snapshot; alpha blends tile motion between its
+  // previous and latest step (0..1). Does not present: the caller calls
+  // SDL_RenderPresent once everything for the frame is drawn.
+  void render(SDL_Renderer *r, const RenderSnapshot &frame, float alpha,
+              int windowW, int windowH, bool gameOverButtonHover);
+
+  // Top-left panel with FPS, the update/render/present split, draw calls and
+  // allocations per frame, input latency (if given) and a frame-time graph.
+  // Draw after render(); its draw calls are added to lastFrameStats().
+  void renderPerfOverlay(SDL_Renderer *r, const FrameStats &stats,
+                         const InputLatency *latency = nullptr);
 
-  void render(SDL_Renderer *r, const Game &game,
-              const std::unordered_map<int, Tile> &tiles, int windowW,
-              int windowH, int score, int bestScore, bool gameOver,
-              bool gameOverButtonHover);
+  // Draws every board of a wall (see the wall layout helpers) with flat
+  // rects batched by color: one fill for the board bases, one for the empty
+  // cells, one per tile exponent on screen and one per text color. Numbers
+  // are left out when cells are too small to read them. Does not present.
+  void renderWall(SDL_Renderer *r, const WallSnapshot &wall, int windowW,
+                  int windowH);
+
+  const RenderStats &lastFrameStats() const { return m_stats; }
 
 private:
+  RenderStats m_stats{};
+
+  // Retained layers (owned; created lazily for the renderer passed to render())
+  SDL_Renderer *m_cacheOwner = nullptr;
+  SDL_Texture *m_staticLayer = nullptr;
+  int m_staticW = 0;
+  int m_staticH = 0;
+  SDL_Texture *m_hudLayer = nullptr;
+  SDL_Rect m_hudRect{0, 0, 0, 0};
+  int m_hudScore = -1;
+  int m_hudBest = -1;
+
+  std::vector<SDL_Rect> m_overlayRects; // reused by overlays
+
+  // Wall batches, reused every frame (indexed by tile exponent).
+  std::vector<SDL_Rect> m_wallBases;
+  std::vector<SDL_Rect> m_wallCells;
+  std::array<std::vector<SDL_Rect>, Palette::kMaxTileExponent + 1>
+      m_wallTiles;
+  std::array<std::vector<SDL_Rect>, Palette::kMaxTileExponent + 1> m_wallText;
+
+  // Translucent arrow across the board pointing at the hinted move; one
+  // batched fill.
+  void drawHintArrow(SDL_Renderer *r, const SDL_Rect &board, Direction dir);
+
+  bool ensureStaticLayer(SDL_Renderer *r, int windowW, int windowH);
+  bool ensureHudLayer(SDL_Renderer *r, int windowW, int windowH, int score,
+                      int bestScore);
+  void drawStaticLayer(SDL_Renderer *r, int windowW, int windowH);
+  void drawHudNumbers(SDL_Renderer *r, int windowW, int windowH, int score,
+                      int bestScore, int offsetX, int offsetY) const;
+
   // Layout helpers
   SDL_Rect boardRect(int windowW, int windowH) const;
   SDL_Rect cellRect(int windowW, int windowH, float row, float col) const;
 
   // Primitives
+  // Rounded rects are 9-sliced: anti-aliased corner masks are generated once
+  // per radius (fill + 1px outline variants) and tinted via color modulation.
+  struct CornerMask
+  {
+    int radius = 0;
+    bool outline = false;
+    SDL_Texture *tex = nullptr;
+  };
+  static constexpr int kCornerMaskSlots = 8;
+  std::array<CornerMask, kCornerMaskSlots> m_cornerMasks{};
+  int m_nextCornerMask = 0;
+
+  SDL_Texture *cornerMask(SDL_Renderer *r, int radius, bool outline);
+  void drawCorners(SDL_Renderer *r, SDL_Texture *mask, const SDL_Rect &rect,
+                   int radius, SDL_Color color);
   void fillRoundRect(SDL_Renderer *r, const SDL_Rect &rect, int radius,
-                     SDL_Color color) const;
+                     SDL_Color color);
+  void strokeRoundRect(SDL_Renderer *r, const SDL_Rect &rect, int radius,
+                       SDL_Color color);
 
   // Number drawing (7 segment)
-  void drawNumber(SDL_Renderer *r, const SDL_Rect &rect, int value) const;
+  // Digit positions relative to the tile rect, cached per (value, w, h) so
+  // steady-state frames neither format nor allocate.
+  struct NumberLayout
+  {
+    int value = -1;
+    int w = 0;
+    int h = 0;
+    int count = 0;
+    int digitW = 0;
+    int digitH = 0;
+    int y = 0;
+    int x[11]{};
+    Uint8 digit[11]{};
+  };
+  static constexpr int kNumberLayoutSlots = 64;
+  std::array<NumberLayout, kNumberLayoutSlots> m_numberLayouts{};
+
+  const NumberLayout &numberLayout(int value, int w, int h);
+  void drawNumber(SDL_Renderer *r, const SDL_Rect &rect, int value,
+                  SDL_Color color);
   void drawDigit(SDL_Renderer *r, int digit, int x, int y, int w, int h,
                  SDL_Color color) const;
 };
@@ -1,205 +1,66 @@
 #include <tiletwister/app/GameControllerObject.hpp>
 
+#include <tiletwister/core/Trace.hpp>
+
 #include <SDL2/SDL.h>
 
 #include <algorithm>
-#include <cstring>
-#include <fstream>
-#include <sstream>
+#include <chrono>
+#include <utility>
 
-GameControllerObject::GameControllerObject(bool *runningFlag)
+GameControllerObject::GameControllerObject(
+    bool *runningFlag, std::unique_ptr<MovePolicy> autoplayPolicy)
     : m_running(runningFlag)
 {
-  loadScores();
-  rebuildTilesFromGrid();
+  m_sim.setAutoplayPolicy(std::move(autoplayPolicy));
+  m_sim.start();
 }
 
-void GameControllerObject::loadScores()
+void GameControllerObject::startAutoplay(int movesPerSec)
 {
-  // Format (simple + human-editable):
-  // best=<int>
-  // last=<int>
-  //
-  // Backward compatible: if file contains just 1 or 2 integers, treat them as
-  // best then last.
-  std::ifstream in(m_scoresPath);
-  if (!in.is_open())
-    return;
-
-  int best = 0;
-  int last = 0;
-  bool bestSet = false;
-  bool lastSet = false;
+  m_autoplaySpeed = std::max(0, movesPerSec);
+  m_autoplayOn = true;
+  InputCommand cmd{InputCommand::Type::Autoplay};
+  cmd.value = m_autoplaySpeed;
+  m_sim.post(cmd);
+}
 
-  std::string line;
-  while (std::getline(in, line))
+void GameControllerObject::changeAutoplaySpeed(int steps)
+{
+  // Next ladder entry above (or below) the current speed.
+  int next = m_autoplaySpeed;
+  if (steps > 0)
   {
-    // Trim
-    while (!line.empty() && (line.back() == '\r' || line.back() == '\n'))
-      line.pop_back();
-    if (line.empty())
-      continue;
-
-    auto parseInt = [](const std::string &s, int &out) -> bool
-    {
-      std::istringstream ss(s);
-      ss >> out;
-      return !ss.fail();
-    };
-
-    const std::string bestPrefix = "best=";
-    const std::string lastPrefix = "last=";
-    if (line.rfind(bestPrefix, 0) == 0)
-    {
-      int v = 0;
-      if (parseInt(line.substr(bestPrefix.size()), v))
-      {
-        best = std::max(0, v);
-        bestSet = true;
-      }
-      continue;
-    }
-    if (line.rfind(lastPrefix, 0) == 0)
-    {
-      int v = 0;
-      if (parseInt(line.substr(lastPrefix.size()), v))
-      {
-        last = std::max(0, v);
-        lastSet = true;
-      }
-      continue;
-    }
-
-    // Fallback: plain integer lines
-    int v = 0;
-    if (parseInt(line, v))
-    {
-      if (!bestSet)
+    for (int speed : kAutoplaySpeeds)
+      if (speed > m_autoplaySpeed)
       {
-        best = std::max(0, v);
-        bestSet = true;
+        next = speed;
+        break;
       }
-      else if (!lastSet)
-      {
-        last = std::max(0, v);
-        lastSet = true;
-      }
-    }
   }
-
-  m_bestScore = best;
-  m_lastScore = last;
-  m_savedBestScore = m_bestScore;
-  m_savedLastScore = m_lastScore;
-}
-
-void GameControllerObject::saveScoresIfNeeded(bool force)
-{
-  const int best = std::max(0, m_bestScore);
-  const int last = std::max(0, m_lastScore);
-
-  if (!force && best == m_savedBestScore && last == m_savedLastScore)
-    return;
-
-  std::ofstream out(m_scoresPath, std::ios::trunc);
-  if (!out.is_open())
-    return;
-
-  out << "best=" << best << "\n";
-  out << "last=" << last << "\n";
-
-  m_savedBestScore = best;
-  m_savedLastScore = last;
-}
-
-int GameControllerObject::keyForCellValue(int r, int c, int value, int ordinal)
-{
-  return (r & 0xF) | ((c & 0xF) << 4) | ((value & 0xFFFF) << 8) |
-         ((ordinal & 0xFF) << 24);
-}
-
-void GameControllerObject::rebuildTilesFromGrid()
-{
-  m_tiles.clear();
-  int counts[16]{};
-  for (int r = 0; r < 4; ++r)
+  else
   {
-    for (int c = 0; c < 4; ++c)
-    {
-      const int v = m_game.grid()[r][c];
-      if (v == 0)
-        continue;
-      const int idx = r * 4 + c;
-      const int ord = counts[idx]++;
-      const int k = keyForCellValue(r, c, v, ord);
-      m_tiles.emplace(k, Tile(v, Cell{r, c}));
-    }
+    for (int speed : kAutoplaySpeeds)
+      if (speed < m_autoplaySpeed)
+        next = speed;
   }
+  m_autoplaySpeed = next;
+  if (m_autoplayOn)
+    startAutoplay(next);
 }
 
-void GameControllerObject::beginMove(Direction dir)
+void GameControllerObject::handleEvent(const SDL_Event &e)
 {
-  if (m_activeMove.active)
-    return;
-
-  int before[4][4]{};
-  std::memcpy(before, m_game.grid(), sizeof(before));
-
-  const MoveResult mr = m_game.tryMove(dir);
-  if (!mr.moved)
-    return;
-
-  if (m_game.score() > m_bestScore)
-  {
-    m_bestScore = m_game.score();
-    saveScoresIfNeeded(false);
-  }
-
-  m_tiles.clear();
-
-  // Build tiles from animation sources.
-  int srcSeen[4][4]{};
-  for (const auto &a : mr.animations)
+  // Cached render-target textures lose their contents on device loss.
+  if (e.type == SDL_RENDER_TARGETS_RESET || e.type == SDL_RENDER_DEVICE_RESET)
   {
-    const int ord = srcSeen[a.from.r][a.from.c]++;
-    const int k = keyForCellValue(a.from.r, a.from.c, a.value, ord);
-    Tile t(a.value, a.from);
-    t.startSlide(a.from, a.to, m_activeMove.duration);
-    m_tiles.emplace(k, t);
+    m_renderer.invalidateCache();
+    return;
   }
 
-  // Add stationary tiles (ones not referenced as a move source).
-  bool usedFrom[4][4]{};
-  for (const auto &a : mr.animations)
-    usedFrom[a.from.r][a.from.c] = true;
-  for (int r = 0; r < 4; ++r)
-  {
-    for (int c = 0; c < 4; ++c)
-    {
-      const int v = before[r][c];
-      if (v == 0)
-        continue;
-      if (usedFrom[r][c])
-        continue;
-      const int k = keyForCellValue(r, c, v, 0);
-      m_tiles.emplace(k, Tile(v, Cell{r, c}));
-    }
-  }
-
-  m_activeMove.active = true;
-  m_activeMove.timeLeft = m_activeMove.duration;
-
-  m_activeMove.pendingPopCells = mr.mergedCells;
-  if (mr.pendingSpawn.has_value())
-    m_activeMove.pendingSpawnCell = mr.pendingSpawn->first;
-  else
-    m_activeMove.pendingSpawnCell.reset();
-}
-
-void GameControllerObject::handleEvent(const SDL_Event &e)
-{
-  // Game-over modal: mouse hover + click to restart.
-  if (m_game.isGameOver())
+  // Game-over modal: mouse hover + click to restart. Hover is purely visual
+  // and stays on this thread.
+  if (m_sim.latestSnapshot().gameOver)
   {
     if (e.type == SDL_MOUSEMOTION)
     {
@@ -223,124 +84,136 @@ void GameControllerObject::handleEvent(const SDL_Event &e)
            my < btn.y + btn.h);
       if (inside)
       {
-        // Save last run score + possibly update best, then reset.
-        m_lastScore = std::max(0, m_game.score());
-        if (m_lastScore > m_bestScore)
-          m_bestScore = m_lastScore;
-        saveScoresIfNeeded(true);
-
-        m_game.reset();
-        m_activeMove.active = false;
-        m_game.commitPendingSpawn();
-        rebuildTilesFromGrid();
+        m_sim.post(InputCommand{InputCommand::Type::Restart});
         m_gameOverButtonHover = false;
       }
       return;
     }
   }
 
-  if (e.type != SDL_KEYDOWN)
+  if (e.type != SDL_KEYDOWN && e.type != SDL_KEYUP)
     return;
 
   const SDL_Keycode key = e.key.keysym.sym;
-  if (key == SDLK_ESCAPE)
+  if (e.type == SDL_KEYDOWN && key == SDLK_ESCAPE)
   {
-    // Persist best/last on quit.
-    saveScoresIfNeeded(true);
+    // The simulation persists best/last and the board before it stops.
+    m_sim.post(InputCommand{InputCommand::Type::Quit});
     if (m_running)
       *m_running = false;
     return;
   }
 
-  if (key == SDLK_r)
+  if (e.type == SDL_KEYDOWN && key == SDLK_F3)
   {
-    // Save last run score + possibly update best, then reset.
-    m_lastScore = std::max(0, m_game.score());
-    if (m_lastScore > m_bestScore)
-      m_bestScore = m_lastScore;
-    saveScoresIfNeeded(true);
-
-    m_game.reset();
-    // Keep best score across resets.
-    m_activeMove.active = false;
-    m_game.commitPendingSpawn();
-    rebuildTilesFromGrid();
-    m_gameOverButtonHover = false;
+    if (!e.key.repeat)
+      m_showPerf = !m_showPerf;
     return;
   }
 
-  if (m_activeMove.active)
-    return;
-
-  if (key == SDLK_LEFT)
-    beginMove(Direction::Left);
-  else if (key == SDLK_RIGHT)
-    beginMove(Direction::Right);
-  else if (key == SDLK_UP)
-    beginMove(Direction::Up);
-  else if (key == SDLK_DOWN)
-    beginMove(Direction::Down);
-}
-
-void GameControllerObject::update(float dtSec)
-{
-  for (auto &kv : m_tiles)
-    kv.second.update(dtSec);
-
-  if (m_game.score() > m_bestScore)
+  if (Trace::kEnabled && e.type == SDL_KEYDOWN && key == SDLK_F9)
   {
-    m_bestScore = m_game.score();
-    saveScoresIfNeeded(false);
+    // On demand, from the main thread: the other threads keep recording.
+    const char *path = "tiletwister_trace.json";
+    if (Trace::writeChromeTrace(path))
+      SDL_Log("trace written to %s", path);
+    return;
   }
 
-  if (!m_activeMove.active)
+  if (e.type == SDL_KEYDOWN && key == SDLK_r)
+  {
+    m_sim.post(InputCommand{InputCommand::Type::Restart});
     return;
+  }
 
-  m_activeMove.timeLeft -= dtSec;
-  if (m_activeMove.timeLeft > 0.0f)
+  if (e.type == SDL_KEYDOWN && key == SDLK_h)
+  {
+    if (!e.key.repeat)
+      m_sim.post(InputCommand{InputCommand::Type::Hint});
     return;
+  }
 
-  m_activeMove.active = false;
-
-  // Commit spawn and rebuild final board tiles.
-  m_game.commitPendingSpawn();
-  rebuildTilesFromGrid();
-
-  // Pop merged destinations.
-  for (const Cell &c : m_activeMove.pendingPopCells)
+  if (e.type == SDL_KEYDOWN && key == SDLK_a)
   {
-    for (auto &kv : m_tiles)
+    if (e.key.repeat)
+      return;
+    if (m_autoplayOn)
     {
-      if (kv.second.cell().r == c.r && kv.second.cell().c == c.c)
-      {
-        kv.second.startPop(0.10f);
-      }
+      m_autoplayOn = false;
+      m_sim.post(InputCommand{InputCommand::Type::Autoplay, Direction::Left,
+                              0, -1});
     }
+    else
+    {
+      startAutoplay(m_autoplaySpeed);
+    }
+    return;
   }
 
-  // Pop newly spawned tile (if any).
-  if (m_activeMove.pendingSpawnCell.has_value())
+  if (e.type == SDL_KEYDOWN && (key == SDLK_EQUALS || key == SDLK_KP_PLUS ||
+                                key == SDLK_MINUS || key == SDLK_KP_MINUS))
   {
-    const Cell c = *m_activeMove.pendingSpawnCell;
-    for (auto &kv : m_tiles)
-    {
-      if (kv.second.cell().r == c.r && kv.second.cell().c == c.c)
-      {
-        kv.second.startPop(0.12f);
-      }
-    }
+    changeAutoplaySpeed(key == SDLK_EQUALS || key == SDLK_KP_PLUS ? 1 : -1);
+    return;
   }
 
-  m_activeMove.pendingPopCells.clear();
-  m_activeMove.pendingSpawnCell.reset();
+  Direction dir;
+  if (key == SDLK_LEFT)
+    dir = Direction::Left;
+  else if (key == SDLK_RIGHT)
+    dir = Direction::Right;
+  else if (key == SDLK_UP)
+    dir = Direction::Up;
+  else if (key == SDLK_DOWN)
+    dir = Direction::Down;
+  else
+    return;
 
-  // If the move ended (spawn committed) and score just increased, persist.
-  saveScoresIfNeeded(false);
+  if (e.type == SDL_KEYUP)
+  {
+    m_sim.post(InputCommand{InputCommand::Type::Release, dir});
+    return;
+  }
+
+  // OS key repeat is slow and platform-dependent; the simulation repeats held
+  // arrows at its own rate instead.
+  if (e.key.repeat)
+    return;
+
+  m_autoplayOn = false; // the simulation stops autoplay on a press
+
+  m_sim.post(InputCommand{InputCommand::Type::Press, dir,
+                          m_latency ? m_latency->lastPollNs() : 0});
+}
+
+void GameControllerObject::update(float)
+{
+  // Game logic runs on the simulation thread.
 }
 
 void GameControllerObject::render(SDL_Renderer *renderer)
 {
-  m_renderer.render(renderer, m_game, m_tiles, m_windowW, m_windowH,
-                    m_game.score(), m_bestScore, m_game.isGameOver(),
-                    m_gameOverButtonHover);
+  const RenderSnapshot &frame = m_sim.latestSnapshot();
+  if (frame.moveSeq != m_shownMoveSeq)
+  {
+    m_shownMoveSeq = frame.moveSeq;
+    if (m_latency)
+      m_latency->frameShowsInput(frame.moveInputNs);
+  }
+
+  // Blend from the snapshot's previous step to its latest one by the time
+  // since it was published (renders trail the simulation by one step).
+  const std::int64_t nowNs =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now().time_since_epoch())
+          .count();
+  float alpha = 1.0f;
+  if (frame.stepSec > 0.0f)
+    alpha = static_cast<float>(nowNs - frame.publishedNs) * 1e-9f /
+            frame.stepSec;
+
+  m_renderer.render(renderer, frame, std::min(1.0f, std::max(0.0f, alpha)),
+                    m_windowW, m_windowH, m_gameOverButtonHover);
+  if (m_showPerf && m_perfStats)
+    m_renderer.renderPerfOverlay(renderer, *m_perfStats, m_latency);
 }
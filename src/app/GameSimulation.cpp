@@ -0,0 +1,579 @@
+#include <tiletwister/app/GameSimulation.hpp>
+
+#include <tiletwister/core/FixedTimestep.hpp>
+#include <tiletwister/core/Metrics.hpp>
+#include <tiletwister/core/Trace.hpp>
+#include <tiletwister/game/SaveFile.hpp>
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <utility>
+
+GameSimulation::GameSimulation()
+    : m_autoplayPolicy(std::make_unique<ExpectimaxPolicy>())
+{
+  m_gameStart = std::chrono::steady_clock::now();
+  loadScores();
+  loadGameState();
+  m_tiles.syncFromGrid(m_game.grid());
+  m_history.open();
+  // A resumed game-over board was recorded by the previous session.
+  m_gameRecorded = m_game.isGameOver();
+  publishSnapshot(0);
+}
+
+GameSimulation::~GameSimulation() { stop(); }
+
+void GameSimulation::setAutoplayPolicy(std::unique_ptr<MovePolicy> policy)
+{
+  if (policy)
+    m_autoplayPolicy = std::move(policy);
+}
+
+void GameSimulation::start()
+{
+  if (m_running.exchange(true))
+    return;
+  m_thread = std::thread([this] { run(); });
+}
+
+void GameSimulation::stop()
+{
+  if (!m_running.exchange(false))
+    return;
+  if (m_thread.joinable())
+    m_thread.join();
+}
+
+void GameSimulation::run()
+{
+  TT_TRACE_THREAD("simulation");
+  using Clock = std::chrono::steady_clock;
+  FixedTimestep clock(kStepSec);
+  const auto stepDuration = std::chrono::duration_cast<Clock::duration>(
+      std::chrono::duration<double>(kStepSec));
+  std::uint64_t stepIndex = 0;
+  auto last = Clock::now();
+  auto next = last + stepDuration;
+
+  while (m_running.load(std::memory_order_acquire))
+  {
+    std::this_thread::sleep_until(next);
+    const auto now = Clock::now();
+    const int steps =
+        clock.advance(std::chrono::duration<double>(now - last).count());
+    last = now;
+    // Fixed schedule; after a hitch, restart it instead of bursting.
+    next += stepDuration;
+    if (next < now)
+      next = now + stepDuration;
+
+    for (int i = 0; i < steps; ++i)
+    {
+      TT_TRACE_SCOPE("GameSimulation::step");
+      drainCommands();
+      step(static_cast<float>(kStepSec));
+      ++stepIndex;
+    }
+    if (steps > 0)
+      publishSnapshot(stepIndex);
+  }
+
+  // Commands posted right before stop() (e.g. Quit) still apply.
+  drainCommands();
+}
+
+void GameSimulation::drainCommands()
+{
+  InputCommand cmd;
+  while (m_commands.pop(cmd))
+    handleCommand(cmd);
+}
+
+void GameSimulation::handleCommand(const InputCommand &cmd)
+{
+  switch (cmd.type)
+  {
+  case InputCommand::Type::Press:
+    // The player takes over from autoplay.
+    if (m_autoplay.active)
+      stopAutoplay();
+    if (!m_inputQueue.push(QueuedMove{cmd.dir, cmd.polledNs}))
+      metrics().droppedInputs.add();
+    m_heldKey = HeldKey{true, cmd.dir, 0.0f, kRepeatDelaySec};
+    break;
+  case InputCommand::Type::Release:
+    if (m_heldKey.active && m_heldKey.dir == cmd.dir)
+      m_heldKey.active = false;
+    break;
+  case InputCommand::Type::Restart:
+    restartGame();
+    break;
+  case InputCommand::Type::Hint:
+    if (!m_game.isGameOver())
+    {
+      // Search the board as it will be once the current slide's spawn
+      // lands, without cutting the slide short.
+      const GameState st = m_game.state();
+      int grid[4][4];
+      std::copy(&st.grid[0][0], &st.grid[0][0] + 16, &grid[0][0]);
+      if (st.pendingSpawn)
+        grid[st.pendingSpawn->first.r][st.pendingSpawn->first.c] =
+            st.pendingSpawn->second;
+      m_hints.request(grid);
+      m_hintPending = true;
+      m_hintShown = false;
+    }
+    break;
+  case InputCommand::Type::Autoplay:
+    if (cmd.value < 0)
+    {
+      stopAutoplay();
+      break;
+    }
+    m_autoplay.active = true;
+    m_autoplay.movesPerSec = cmd.value;
+    m_autoplay.credit = 0.0f;
+    m_inputQueue.clear();
+    m_heldKey.active = false;
+    break;
+  case InputCommand::Type::Quit:
+    // Persist best/last and the board on quit.
+    saveScoresIfNeeded(true);
+    checkpointGameState();
+    break;
+  }
+}
+
+void GameSimulation::publishSnapshot(std::uint64_t stepIndex)
+{
+  TT_TRACE_SCOPE("GameSimulation::publishSnapshot");
+  syncStaleTiles();
+  RenderSnapshot &s = m_snapshots.writeBuffer();
+  captureTiles(m_tiles, s);
+  s.score = m_game.score();
+  s.bestScore = m_bestScore;
+  s.gameOver = m_game.isGameOver();
+  s.step = stepIndex;
+  s.hintShown = m_hintShown;
+  s.hintPending = m_hintPending;
+  s.hintDir = m_hintDir;
+  s.autoplayMovesPerSec = m_autoplay.active ? m_autoplay.movesPerSec : -1;
+  s.moveSeq = m_moveSeq;
+  s.moveInputNs = m_moveInputNs;
+  metrics().score.set(s.score);
+  metrics().bestScore.set(s.bestScore);
+  s.stepSec = static_cast<float>(kStepSec);
+  s.publishedNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                      std::chrono::steady_clock::now().time_since_epoch())
+                      .count();
+  m_snapshots.publish();
+}
+
+void GameSimulation::loadGameState()
+{
+  // Resume the previous session before the first frame: one fixed-size read,
+  // no parsing. A spawn left pending by a mid-move quit is applied now.
+  GameState st;
+  if (!loadSaveFile(m_savePath, st))
+    return;
+  m_game.restore(st);
+  m_game.commitPendingSpawn();
+  // Count the earlier sessions' play time in the game's duration.
+  m_gameStart -= std::chrono::milliseconds(st.playedMs);
+}
+
+void GameSimulation::checkpointGameState()
+{
+  if (m_autoplayedGame)
+    return;
+  TT_TRACE_SCOPE("GameSimulation::checkpoint");
+  GameState st = m_game.state();
+  st.playedMs = playedMs();
+  m_fileWriter.submit(m_savePath, saveBytes(st));
+}
+
+std::uint32_t GameSimulation::playedMs() const
+{
+  return static_cast<std::uint32_t>(
+      std::chrono::duration_cast<std::chrono::milliseconds>(
+          std::chrono::steady_clock::now() - m_gameStart)
+          .count());
+}
+
+void GameSimulation::recordFinishedGame()
+{
+  // One 32-byte append per finished (or abandoned) game.
+  if (m_gameRecorded || m_game.moveCount() == 0)
+    return;
+  m_gameRecorded = true;
+  metrics().games.add();
+  if (m_autoplayedGame)
+    return;
+
+  int maxTile = 0;
+  for (const auto &row : m_game.grid())
+    for (int v : row)
+      maxTile = std::max(maxTile, v);
+
+  GameRecord rec{};
+  rec.finishedAtMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+                         std::chrono::system_clock::now().time_since_epoch())
+                         .count();
+  rec.seed = m_game.seed();
+  rec.score = m_game.score();
+  rec.maxTile = maxTile;
+  rec.moveCount = m_game.moveCount();
+  rec.durationMs = playedMs();
+  m_history.append(rec);
+}
+
+void GameSimulation::loadScores()
+{
+  // Format (simple + human-editable):
+  // best=<int>
+  // last=<int>
+  //
+  // Backward compatible: if file contains just 1 or 2 integers, treat them as
+  // best then last.
+  std::ifstream in(m_scoresPath);
+  if (!in.is_open())
+    return;
+
+  int best = 0;
+  int last = 0;
+  bool bestSet = false;
+  bool lastSet = false;
+
+  std::string line;
+  while (std::getline(in, line))
+  {
+    // Trim
+    while (!line.empty() && (line.back() == '\r' || line.back() == '\n'))
+      line.pop_back();
+    if (line.empty())
+      continue;
+
+    auto parseInt = [](const std::string &s, int &out) -> bool
+    {
+      std::istringstream ss(s);
+      ss >> out;
+      return !ss.fail();
+    };
+
+    const std::string bestPrefix = "best=";
+    const std::string lastPrefix = "last=";
+    if (line.rfind(bestPrefix, 0) == 0)
+    {
+      int v = 0;
+      if (parseInt(line.substr(bestPrefix.size()), v))
+      {
+        best = std::max(0, v);
+        bestSet = true;
+      }
+      continue;
+    }
+    if (line.rfind(lastPrefix, 0) == 0)
+    {
+      int v = 0;
+      if (parseInt(line.substr(lastPrefix.size()), v))
+      {
+        last = std::max(0, v);
+        lastSet = true;
+      }
+      continue;
+    }
+
+    // Fallback: plain integer lines
+    int v = 0;
+    if (parseInt(line, v))
+    {
+      if (!bestSet)
+      {
+        best = std::max(0, v);
+        bestSet = true;
+      }
+      else if (!lastSet)
+      {
+        last = std::max(0, v);
+        lastSet = true;
+      }
+    }
+  }
+
+  m_bestScore = best;
+  m_lastScore = last;
+  m_savedBestScore = m_bestScore;
+  m_savedLastScore = m_lastScore;
+}
+
+void GameSimulation::saveScoresIfNeeded(bool force)
+{
+  const int best = std::max(0, m_bestScore);
+  const int last = std::max(0, m_lastScore);
+
+  if (!force && best == m_savedBestScore && last == m_savedLastScore)
+    return;
+  TT_TRACE_SCOPE("GameSimulation::saveScores");
+
+  // Queued for the background writer (temp file + fsync + rename); the frame
+  // thread never touches the disk here.
+  std::string contents = "best=" + std::to_string(best) + "\n";
+  contents += "last=" + std::to_string(last) + "\n";
+  m_fileWriter.submit(m_scoresPath, std::move(contents));
+
+  m_savedBestScore = best;
+  m_savedLastScore = last;
+}
+
+bool GameSimulation::beginMove(const QueuedMove &move)
+{
+  // Input arriving mid-slide fast-forwards the current move rather than
+  // being dropped.
+  if (m_activeMove.active)
+    finishActiveMove();
+
+  const MoveResult mr = m_game.tryMove(move.dir);
+  if (!mr.moved)
+    return false;
+  metrics().moves.add();
+  dropHint(); // it was for the previous board
+  ++m_moveSeq;
+  m_moveInputNs = move.polledNs;
+
+  if (!m_autoplayedGame && m_game.score() > m_bestScore)
+  {
+    m_bestScore = m_game.score();
+    saveScoresIfNeeded(false);
+  }
+
+  // Existing tiles slide in place (stable ids); merges/spawn resolve at the
+  // end of the move.
+  m_tiles.beginMove(mr, m_activeMove.duration);
+
+  m_activeMove.active = true;
+  m_activeMove.timeLeft = m_activeMove.duration;
+  return true;
+}
+
+void GameSimulation::finishActiveMove()
+{
+  m_activeMove.active = false;
+
+  // Commit spawn, then pop merged destinations and the new tile.
+  m_game.commitPendingSpawn();
+  m_tiles.finishMove(m_game.grid());
+
+  // If the move ended (spawn committed) and score just increased, persist.
+  saveScoresIfNeeded(false);
+  checkpointGameState();
+  if (m_game.isGameOver())
+    recordFinishedGame();
+}
+
+void GameSimulation::restartGame()
+{
+  // Save last run score + possibly update best, then reset.
+  if (!m_autoplayedGame)
+  {
+    m_lastScore = std::max(0, m_game.score());
+    if (m_lastScore > m_bestScore)
+      m_bestScore = m_lastScore;
+    saveScoresIfNeeded(true);
+  }
+  recordFinishedGame();
+
+  dropHint();
+  m_game.reset();
+  // Keep best score across resets.
+  m_activeMove.active = false;
+  m_inputQueue.clear();
+  m_heldKey.active = false;
+  m_game.commitPendingSpawn();
+  m_tiles.syncFromGrid(m_game.grid());
+  m_gameStart = std::chrono::steady_clock::now();
+  m_gameRecorded = false;
+  // A game started by autoplay must not replace the saved one.
+  m_autoplayedGame = m_autoplay.active;
+  checkpointGameState();
+}
+
+void GameSimulation::dropHint()
+{
+  if (m_hintPending)
+    m_hints.cancel();
+  m_hintPending = false;
+  m_hintShown = false;
+}
+
+void GameSimulation::step(float dtSec)
+{
+  m_tiles.update(dtSec);
+
+  HintService::Hint hint;
+  if (m_hintPending && m_hints.poll(hint))
+  {
+    m_hintPending = false;
+    m_hintShown = true;
+    m_hintDir = hint.dir;
+  }
+
+  if (!m_autoplayedGame && m_game.score() > m_bestScore)
+  {
+    m_bestScore = m_game.score();
+    saveScoresIfNeeded(false);
+  }
+
+  // Held arrow: repeat at kRepeatIntervalSec after the initial delay. Only
+  // queue a repeat once the previous one has been consumed, so a held key
+  // never builds up a backlog.
+  if (m_heldKey.active)
+  {
+    m_heldKey.elapsed += dtSec;
+    if (m_heldKey.elapsed >= m_heldKey.nextRepeat)
+    {
+      if (m_inputQueue.count == 0)
+        m_inputQueue.push(QueuedMove{m_heldKey.dir, 0});
+      while (m_heldKey.nextRepeat <= m_heldKey.elapsed)
+        m_heldKey.nextRepeat += kRepeatIntervalSec;
+    }
+  }
+
+  if (m_activeMove.active)
+  {
+    m_activeMove.timeLeft -= dtSec;
+    if (m_activeMove.timeLeft <= 0.0f)
+      finishActiveMove();
+  }
+
+  // Start at most one queued move per step; beginMove fast-forwards the
+  // current slide if it is still running. Moves that don't change the board
+  // are skipped.
+  while (m_inputQueue.count > 0)
+  {
+    if (beginMove(m_inputQueue.pop()))
+      break;
+  }
+
+  if (m_autoplay.active)
+    stepAutoplay(dtSec);
+}
+
+void GameSimulation::stepAutoplay(float dtSec)
+{
+  const int speed = m_autoplay.movesPerSec;
+  const bool fast = speed > kMaxAnimatedMovesPerSec;
+
+  if (m_game.isGameOver())
+  {
+    // Let the final board be seen, unless it would only cost throughput.
+    m_autoplay.gameOverSec += dtSec;
+    if (!fast && m_autoplay.gameOverSec < kAutoplayRestartSec)
+      return;
+    m_autoplay.gameOverSec = 0.0f;
+    restartGame();
+  }
+
+  if (speed == 0)
+  {
+    if (m_activeMove.active)
+      return;
+  }
+  else
+  {
+    m_autoplay.credit += static_cast<float>(speed) * dtSec;
+    if (m_autoplay.credit < 1.0f)
+      return;
+  }
+  // The policy decides on the settled board (pending spawn applied).
+  if (m_activeMove.active)
+    finishActiveMove();
+
+  if (!fast)
+  {
+    if (speed > 0)
+      m_autoplay.credit = std::min(m_autoplay.credit - 1.0f, 1.0f);
+    // Slides shorten to fit the move interval.
+    m_activeMove.duration =
+        speed == 0 ? kSlideSec
+                   : std::min(kSlideSec, 1.0f / static_cast<float>(speed));
+    playAutoplayMove(true);
+    return;
+  }
+
+  // Fast: moves only touch Game. The visual tiles, the save checkpoint and
+  // the snapshot follow the latest board once per publish (syncStaleTiles).
+  TT_TRACE_SCOPE("GameSimulation::autoplayBurst");
+  const int owed = static_cast<int>(m_autoplay.credit);
+  m_autoplay.credit -= static_cast<float>(owed);
+  const auto deadline = std::chrono::steady_clock::now() + kAutoplayStepBudget;
+  int played = 0;
+  for (int i = 0; i < owed; ++i)
+  {
+    if (m_game.isGameOver())
+      restartGame();
+    if (!playAutoplayMove(false))
+      break;
+    ++played;
+    if ((played & 63) == 0 && std::chrono::steady_clock::now() > deadline)
+    {
+      m_autoplay.credit = 0.0f;
+      break;
+    }
+  }
+  if (played == 0)
+    return;
+  metrics().moves.add(static_cast<std::uint64_t>(played));
+  dropHint();
+  m_tilesStale = true;
+}
+
+bool GameSimulation::playAutoplayMove(bool animate)
+{
+  m_autoplayedGame = true;
+  auto play = [&](Direction dir)
+  {
+    if (animate)
+      return beginMove(QueuedMove{dir, 0});
+    if (!m_game.tryMove(dir).moved)
+      return false;
+    m_game.commitPendingSpawn();
+    ++m_moveSeq;
+    m_moveInputNs = 0;
+    return true;
+  };
+
+  Direction dir = Direction::Left;
+  if (m_autoplayPolicy && m_autoplayPolicy->chooseMove(m_game.grid(), dir) &&
+      play(dir))
+    return true;
+  // The policy had nothing (or something illegal): keep the game going.
+  for (const Direction d : {Direction::Down, Direction::Left,
+                            Direction::Right, Direction::Up})
+  {
+    if (play(d))
+      return true;
+  }
+  return false;
+}
+
+void GameSimulation::stopAutoplay()
+{
+  m_autoplay.active = false;
+  m_activeMove.duration = kSlideSec;
+  syncStaleTiles();
+}
+
+void GameSimulation::syncStaleTiles()
+{
+  if (!m_tilesStale)
+    return;
+  m_tilesStale = false;
+  // Tiles appear at their cells with no slide or pop: at this speed the
+  // moves in between were never going to be seen.
+  m_tiles.syncFromGrid(m_game.grid());
+  checkpointGameState();
+  if (m_game.isGameOver())
+    recordFinishedGame();
+}
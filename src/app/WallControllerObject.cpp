@@ -0,0 +1,50 @@
+#include <tiletwister/app/WallControllerObject.hpp>
+
+#include <tiletwister/core/Trace.hpp>
+
+#include <SDL2/SDL.h>
+
+WallControllerObject::WallControllerObject(bool *runningFlag, int boards,
+                                           int workers,
+                                           const std::string &policy,
+                                           int movesPerSec)
+    : m_running(runningFlag),
+      m_wall(boards, workers, policy, movesPerSec,
+             SDL_GetPerformanceCounter())
+{
+  m_wall.start();
+}
+
+void WallControllerObject::handleEvent(const SDL_Event &e)
+{
+  if (e.type == SDL_RENDER_TARGETS_RESET || e.type == SDL_RENDER_DEVICE_RESET)
+  {
+    m_renderer.invalidateCache();
+    return;
+  }
+  if (e.type != SDL_KEYDOWN)
+    return;
+
+  const SDL_Keycode key = e.key.keysym.sym;
+  if (key == SDLK_ESCAPE)
+  {
+    if (m_running)
+      *m_running = false;
+    return;
+  }
+  if (key == SDLK_F3 && !e.key.repeat)
+    m_showPerf = !m_showPerf;
+}
+
+void WallControllerObject::update(float)
+{
+  // Games run on the wall's worker threads.
+}
+
+void WallControllerObject::render(SDL_Renderer *renderer)
+{
+  m_wall.snapshot(m_snapshot);
+  m_renderer.renderWall(renderer, m_snapshot, m_windowW, m_windowH);
+  if (m_showPerf && m_perfStats)
+    m_renderer.renderPerfOverlay(renderer, *m_perfStats);
+}
@@ -1,49 +1,227 @@
 #include <tiletwister/app/GameControllerObject.hpp>
+#include <tiletwister/app/WallControllerObject.hpp>
+#include <tiletwister/core/AllocHooks.hpp>
+#include <tiletwister/core/FrameStats.hpp>
+#include <tiletwister/core/InputLatency.hpp>
+#include <tiletwister/core/Metrics.hpp>
+#include <tiletwister/core/MetricsExporter.hpp>
+#include <tiletwister/core/Trace.hpp>
 #include <tiletwister/engine/Scene.hpp>
+#include <tiletwister/game/MovePolicy.hpp>
+#include <tiletwister/platform/FramePacer.hpp>
 #include <tiletwister/platform/Window.hpp>
 
 #include <SDL2/SDL.h>
 
 #include <cstdint>
+#include <cstdlib>
+#include <cstring>
 #include <memory>
+#include <string>
 
-int main(int, char**) {
+namespace {
+
+// Frame cap used with --no-vsync when neither --fps nor the display rate is
+// known.
+constexpr int kFallbackFps = 60;
+// Input latency is logged every this many measured moves (and at exit).
+constexpr std::uint64_t kLatencyLogEvery = 100;
+// Wall view defaults: per-board speed unless --autoplay-speed says otherwise,
+// and a larger window.
+constexpr int kWallMovesPerSec = 10;
+constexpr int kWallWindowSize = 960;
+
+struct Options {
+  bool vsync = true;
+  int maxFps = -1; // -1 = default (display rate without vsync, else none)
+  bool showPerf = false;
+  std::string statsFile;   // metrics text file, rewritten every interval
+  std::string statsSocket; // Unix socket serving the same text
+  int statsIntervalMs = 1000;
+  bool autoplay = false;
+  std::string autoplayPolicy = "expectimax";
+  int autoplaySpeed = 0; // moves/sec; 0 = one per slide animation
+  int wallBoards = 0;    // > 0: wall view of that many games
+  int wallWorkers = 0;   // 0 = one per hardware thread
+};
+
+Options parseOptions(int argc, char** argv) {
+  Options opt;
+  for (int i = 1; i < argc; ++i) {
+    if (std::strcmp(argv[i], "--no-vsync") == 0) {
+      opt.vsync = false;
+    } else if (std::strcmp(argv[i], "--fps") == 0 && i + 1 < argc) {
+      opt.maxFps = std::atoi(argv[++i]);
+    } else if (std::strcmp(argv[i], "--perf") == 0) {
+      opt.showPerf = true;
+    } else if (std::strcmp(argv[i], "--stats-file") == 0 && i + 1 < argc) {
+      opt.statsFile = argv[++i];
+    } else if (std::strcmp(argv[i], "--stats-socket") == 0 && i + 1 < argc) {
+      opt.statsSocket = argv[++i];
+    } else if (std::strcmp(argv[i], "--stats-interval") == 0 &&
+               i + 1 < argc) {
+      opt.statsIntervalMs = std::atoi(argv[++i]);
+    } else if (std::strcmp(argv[i], "--autoplay") == 0) {
+      opt.autoplay = true;
+    } else if (std::strcmp(argv[i], "--autoplay-policy") == 0 &&
+               i + 1 < argc) {
+      opt.autoplayPolicy = argv[++i];
+    } else if (std::strcmp(argv[i], "--autoplay-speed") == 0 &&
+               i + 1 < argc) {
+      opt.autoplay = true;
+      opt.autoplaySpeed = std::atoi(argv[++i]);
+    } else if (std::strcmp(argv[i], "--wall") == 0 && i + 1 < argc) {
+      opt.wallBoards = std::atoi(argv[++i]);
+    } else if (std::strcmp(argv[i], "--wall-workers") == 0 && i + 1 < argc) {
+      opt.wallWorkers = std::atoi(argv[++i]);
+    }
+  }
+  return opt;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  const Options opt = parseOptions(argc, argv);
+  TT_TRACE_THREAD("main");
+
+  const bool wall = opt.wallBoards > 0;
+  const int windowSize = wall ? kWallWindowSize : 600;
   Window win;
-  if (!win.init("Tile Twister 2048", 600, 600)) {
+  if (!win.init("Tile Twister 2048", windowSize, windowSize, opt.vsync)) {
     return 1;
   }
 
+  int maxFps = opt.maxFps;
+  if (maxFps < 0) {
+    const int refresh = win.refreshRate();
+    maxFps = opt.vsync ? 0 : (refresh > 0 ? refresh : kFallbackFps);
+  }
+
+  // Off unless asked for; the frame loop only bumps relaxed atomics.
+  MetricsExporter exporter(metrics(), opt.statsFile, opt.statsSocket,
+                           opt.statsIntervalMs);
+  if ((!opt.statsFile.empty() || !opt.statsSocket.empty()) &&
+      !exporter.start()) {
+    SDL_Log("metrics export disabled: can't listen on %s",
+            opt.statsSocket.c_str());
+  }
+
   bool running = true;
-  Uint64 last = SDL_GetPerformanceCounter();
-
-  Scene scene;
-  auto controller = std::make_unique<GameControllerObject>(&running);
-  controller->setWindowSize(win.width(), win.height());
-  scene.add(std::move(controller));
-
-  while (running) {
-    // Timing
-    const Uint64 now = SDL_GetPerformanceCounter();
-    const double freq = static_cast<double>(SDL_GetPerformanceFrequency());
-    const float dt = static_cast<float>((now - last) / freq);
-    last = now;
-
-    // Input
-    SDL_Event e;
-    while (SDL_PollEvent(&e)) {
-      if (e.type == SDL_QUIT) {
-        running = false;
-      } else {
-        scene.handleEvent(e);
-      }
+  FramePacer pacer(maxFps);
+  FrameStats perf;
+  InputLatency latency;
+  auto logLatency = [&latency] {
+    SDL_Log("input latency: p50 %.1f ms, p99 %.1f ms (%llu moves)",
+            latency.percentileMs(0.5), latency.percentileMs(0.99),
+            static_cast<unsigned long long>(latency.count()));
+  };
+  const double freq = static_cast<double>(SDL_GetPerformanceFrequency());
+  auto msBetween = [freq](Uint64 from, Uint64 to) {
+    return static_cast<float>(static_cast<double>(to - from) * 1000.0 / freq);
+  };
+
+  {
+    // Scoped so the scene (and the textures its renderer caches) is torn down
+    // before the SDL_Renderer owned by the window.
+    Scene scene;
+    auto policy =
+        makeMovePolicy(opt.autoplayPolicy, SDL_GetPerformanceCounter());
+    if (!policy) {
+      SDL_Log("unknown autoplay policy '%s' (random, corner, expectimax)",
+              opt.autoplayPolicy.c_str());
     }
+    const RenderStats* renderStats = nullptr;
+    if (wall) {
+      const int speed =
+          opt.autoplaySpeed > 0 ? opt.autoplaySpeed : kWallMovesPerSec;
+      auto controller = std::make_unique<WallControllerObject>(
+          &running, opt.wallBoards, opt.wallWorkers, opt.autoplayPolicy,
+          speed);
+      controller->setWindowSize(win.width(), win.height());
+      controller->setPerfStats(&perf, opt.showPerf);
+      renderStats = &controller->renderStats();
+      scene.add(std::move(controller));
+    } else {
+      auto controller =
+          std::make_unique<GameControllerObject>(&running, std::move(policy));
+      controller->setWindowSize(win.width(), win.height());
+      controller->setPerfStats(&perf, opt.showPerf);
+      controller->setInputLatency(&latency);
+      if (opt.autoplay) controller->startAutoplay(opt.autoplaySpeed);
+      renderStats = &controller->renderStats();
+      scene.add(std::move(controller));
+    }
+
+    // A frame's sample is pushed at the start of the next one, when its full
+    // length (pacing included) is known.
+    FrameSample sample;
+    Uint64 frameStart = SDL_GetPerformanceCounter();
+    bool haveSample = false;
+
+    while (running) {
+      TT_TRACE_SCOPE("frame");
+      // Timing
+      const Uint64 now = SDL_GetPerformanceCounter();
+      const double frameSec = static_cast<double>(now - frameStart) / freq;
+      if (haveSample) {
+        sample.frameMs = msBetween(frameStart, now);
+        perf.push(sample);
+        metrics().frames.add();
+        metrics().frameTimeUs.record(
+            static_cast<std::uint64_t>(sample.frameMs * 1000.0f));
+      }
+      frameStart = now;
+      const std::uint64_t allocsBefore = AllocHooks::process().allocations;
+
+      // Input
+      {
+        TT_TRACE_SCOPE("events");
+        SDL_Event e;
+        while (SDL_PollEvent(&e)) {
+          if (e.type == SDL_QUIT) {
+            running = false;
+            continue;
+          }
+          if (e.type == SDL_KEYDOWN && !e.key.repeat)
+            latency.keyPolled(InputLatency::nowNs());
+          scene.handleEvent(e);
+        }
+      }
+
+      // Game logic steps on its own thread (GameSimulation, GameWall) and the
+      // controllers blend its snapshots when rendering: the scene only needs
+      // one update per frame for lifetimes.
+      scene.update(static_cast<float>(frameSec));
+      const Uint64 updated = SDL_GetPerformanceCounter();
 
-    scene.update(dt);
-    scene.render(win.renderer());
+      scene.render(win.renderer());
+      const Uint64 rendered = SDL_GetPerformanceCounter();
+
+      {
+        TT_TRACE_SCOPE("present");
+        SDL_RenderPresent(win.renderer());
+      }
+      const Uint64 presented = SDL_GetPerformanceCounter();
+      if (latency.presented(InputLatency::nowNs()) &&
+          latency.count() % kLatencyLogEvery == 0)
+        logLatency();
+
+      sample.updateMs = msBetween(now, updated);
+      sample.renderMs = msBetween(updated, rendered);
+      sample.presentMs = msBetween(rendered, presented);
+      sample.drawCalls = renderStats->drawCalls;
+      sample.allocations = static_cast<int>(
+          AllocHooks::process().allocations - allocsBefore);
+      haveSample = true;
+
+      TT_TRACE_SCOPE("pace");
+      pacer.wait();
+    }
   }
 
+  if (latency.count() > 0) logLatency();
+  exporter.stop();
   win.shutdown();
   return 0;
 }
-
-
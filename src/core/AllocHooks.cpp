@@ -0,0 +1,65 @@
+#include <tiletwister/core/AllocHooks.hpp>
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+std::atomic<std::uint64_t> g_allocations{0};
+std::atomic<std::uint64_t> g_bytes{0};
+// Plain thread_locals: no constructor runs inside operator new.
+thread_local std::uint64_t t_allocations = 0;
+thread_local std::uint64_t t_bytes = 0;
+
+void* countedAlloc(std::size_t size) noexcept {
+  g_allocations.fetch_add(1, std::memory_order_relaxed);
+  g_bytes.fetch_add(size, std::memory_order_relaxed);
+  ++t_allocations;
+  t_bytes += size;
+  return std::malloc(size ? size : 1);
+}
+
+void* countedAllocOrThrow(std::size_t size) {
+  if (void* p = countedAlloc(size)) return p;
+  throw std::bad_alloc();
+}
+
+} // namespace
+
+namespace AllocHooks {
+
+Counts process() {
+  Counts c;
+  c.allocations = g_allocations.load(std::memory_order_relaxed);
+  c.bytes = g_bytes.load(std::memory_order_relaxed);
+  return c;
+}
+
+Counts thread() {
+  Counts c;
+  c.allocations = t_allocations;
+  c.bytes = t_bytes;
+  return c;
+}
+
+} // namespace AllocHooks
+
+// Over-aligned new/delete keep the library versions (they don't pair with
+// malloc/free on every platform) and are not counted.
+void* operator new(std::size_t size) { return countedAllocOrThrow(size); }
+void* operator new[](std::size_t size) { return countedAllocOrThrow(size); }
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+  return countedAlloc(size);
+}
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+  return countedAlloc(size);
+}
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { std::free(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept {
+  std::free(p);
+}
@@ -0,0 +1,199 @@
+#include <tiletwister/core/AsyncFileWriter.hpp>
+
+#include <tiletwister/core/Metrics.hpp>
+#include <tiletwister/core/Trace.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <utility>
+
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
+#include <sys/stat.h>
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+#ifdef _WIN32
+
+bool writeAndSync(const std::string& path, const std::string& contents,
+                  bool append, bool sync = true) {
+  const int mode = append ? _O_APPEND : _O_TRUNC;
+  const int fd = _open(path.c_str(), _O_WRONLY | _O_CREAT | mode | _O_BINARY,
+                       _S_IREAD | _S_IWRITE);
+  if (fd < 0) return false;
+  const char* p = contents.data();
+  size_t left = contents.size();
+  bool ok = true;
+  while (left > 0) {
+    const int n = _write(fd, p, static_cast<unsigned>(left));
+    if (n <= 0) {
+      ok = false;
+      break;
+    }
+    p += n;
+    left -= static_cast<size_t>(n);
+  }
+  ok = ok && (!sync || _commit(fd) == 0);
+  return (_close(fd) == 0) && ok;
+}
+
+bool replaceFile(const std::string& from, const std::string& to) {
+  return MoveFileExA(from.c_str(), to.c_str(),
+                     MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+}
+
+#else
+
+bool writeAndSync(const std::string& path, const std::string& contents,
+                  bool append, bool sync = true) {
+  const int mode = append ? O_APPEND : O_TRUNC;
+  const int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | mode, 0644);
+  if (fd < 0) return false;
+  const char* p = contents.data();
+  size_t left = contents.size();
+  bool ok = true;
+  while (left > 0) {
+    const ssize_t n = ::write(fd, p, left);
+    if (n <= 0) {
+      ok = false;
+      break;
+    }
+    p += n;
+    left -= static_cast<size_t>(n);
+  }
+  ok = ok && (!sync || ::fsync(fd) == 0);
+  return (::close(fd) == 0) && ok;
+}
+
+bool replaceFile(const std::string& from, const std::string& to) {
+  return std::rename(from.c_str(), to.c_str()) == 0;
+}
+
+#endif
+
+} // namespace
+
+bool writeFileAtomic(const std::string& path, const std::string& contents,
+                     bool durable) {
+  const std::string tmp = path + ".tmp";
+  if (!writeAndSync(tmp, contents, false, durable) ||
+      !replaceFile(tmp, path)) {
+    std::remove(tmp.c_str());
+    return false;
+  }
+  return true;
+}
+
+bool appendFileSynced(const std::string& path, const std::string& bytes) {
+  return writeAndSync(path, bytes, true);
+}
+
+AsyncFileWriter::AsyncFileWriter(int coalesceMs)
+    : m_coalesceMs(coalesceMs < 0 ? 0 : coalesceMs),
+      m_thread([this] { run(); }) {}
+
+AsyncFileWriter::~AsyncFileWriter() {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stop = true;
+  }
+  m_wake.notify_all();
+  m_thread.join(); // run() drains m_pending before exiting
+}
+
+void AsyncFileWriter::submit(const std::string& path, std::string contents) {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    Pending& p = m_pending[path];
+    p.data = std::move(contents);
+    p.append = false;
+  }
+  m_wake.notify_one();
+}
+
+void AsyncFileWriter::append(const std::string& path, const std::string& bytes) {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    // Appended after a queued replace: still one write (replace with both).
+    auto it = m_pending.find(path);
+    if (it == m_pending.end())
+      m_pending.emplace(path, Pending{bytes, true});
+    else
+      it->second.data += bytes;
+  }
+  m_wake.notify_one();
+}
+
+void AsyncFileWriter::flush() {
+  std::unique_lock<std::mutex> lock(m_mutex);
+  m_flushRequested = true;
+  m_wake.notify_one();
+  m_idle.wait(lock, [this] { return m_pending.empty() && !m_busy; });
+  m_flushRequested = false;
+}
+
+std::uint64_t AsyncFileWriter::writesCompleted() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_completed;
+}
+
+std::uint64_t AsyncFileWriter::writesFailed() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_failed;
+}
+
+void AsyncFileWriter::run() {
+  TT_TRACE_THREAD("file-writer");
+  std::unique_lock<std::mutex> lock(m_mutex);
+  for (;;) {
+    m_wake.wait(lock, [this] { return m_stop || !m_pending.empty(); });
+    if (m_pending.empty()) {
+      if (m_stop) return;
+      continue;
+    }
+
+    // Let a burst of updates land before writing (skipped on flush/stop).
+    if (m_coalesceMs > 0 && !m_stop && !m_flushRequested) {
+      m_wake.wait_for(lock, std::chrono::milliseconds(m_coalesceMs),
+                      [this] { return m_stop || m_flushRequested; });
+    }
+
+    std::map<std::string, Pending> batch;
+    batch.swap(m_pending);
+    m_busy = true;
+    lock.unlock();
+
+    std::uint64_t ok = 0;
+    std::uint64_t failed = 0;
+    for (const auto& kv : batch) {
+      TT_TRACE_SCOPE("AsyncFileWriter::write");
+      const auto t0 = std::chrono::steady_clock::now();
+      const bool written = kv.second.append
+                               ? appendFileSynced(kv.first, kv.second.data)
+                               : writeFileAtomic(kv.first, kv.second.data);
+      metrics().saveLatencyUs.record(static_cast<std::uint64_t>(
+          std::chrono::duration_cast<std::chrono::microseconds>(
+              std::chrono::steady_clock::now() - t0)
+              .count()));
+      if (written) {
+        ++ok;
+        metrics().saves.add();
+      } else {
+        ++failed;
+        metrics().saveFailures.add();
+      }
+    }
+
+    lock.lock();
+    m_busy = false;
+    m_completed += ok;
+    m_failed += failed;
+    if (m_pending.empty()) m_idle.notify_all();
+  }
+}
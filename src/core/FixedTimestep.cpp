@@ -0,0 +1,21 @@
+#include <tiletwister/core/FixedTimestep.hpp>
+
+FixedTimestep::FixedTimestep(double stepSec, int maxStepsPerFrame)
+    : m_step(stepSec > 0.0 ? stepSec : 1.0 / 120.0),
+      m_maxSteps(maxStepsPerFrame > 0 ? maxStepsPerFrame : 1) {}
+
+int FixedTimestep::advance(double frameSec) {
+  if (frameSec > 0.0) m_accumulator += frameSec;
+
+  int steps = static_cast<int>(m_accumulator / m_step);
+  if (steps > m_maxSteps) {
+    // Keep the sub-step remainder so alpha stays continuous.
+    const double excess = (steps - m_maxSteps) * m_step;
+    m_dropped += excess;
+    m_accumulator -= excess;
+    steps = m_maxSteps;
+  }
+  m_accumulator -= steps * m_step;
+  if (m_accumulator < 0.0) m_accumulator = 0.0; // rounding
+  return steps;
+}
@@ -0,0 +1,40 @@
+#include <tiletwister/core/FrameStats.hpp>
+
+#include <cmath>
+
+FrameSample FrameStats::average() const {
+  FrameSample avg;
+  if (m_count == 0) return avg;
+
+  double frame = 0.0, update = 0.0, render = 0.0, present = 0.0;
+  double draws = 0.0, allocs = 0.0;
+  for (int i = 0; i < m_count; ++i) {
+    const FrameSample& s = at(i);
+    frame += s.frameMs;
+    update += s.updateMs;
+    render += s.renderMs;
+    present += s.presentMs;
+    draws += s.drawCalls;
+    allocs += s.allocations;
+  }
+  avg.frameMs = static_cast<float>(frame / m_count);
+  avg.updateMs = static_cast<float>(update / m_count);
+  avg.renderMs = static_cast<float>(render / m_count);
+  avg.presentMs = static_cast<float>(present / m_count);
+  avg.drawCalls = static_cast<int>(std::lround(draws / m_count));
+  avg.allocations = static_cast<int>(std::lround(allocs / m_count));
+  return avg;
+}
+
+float FrameStats::maxFrameMs() const {
+  float worst = 0.0f;
+  for (int i = 0; i < m_count; ++i) {
+    if (at(i).frameMs > worst) worst = at(i).frameMs;
+  }
+  return worst;
+}
+
+float FrameStats::fps() const {
+  const float ms = average().frameMs;
+  return ms > 0.0f ? 1000.0f / ms : 0.0f;
+}
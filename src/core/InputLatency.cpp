@@ -0,0 +1,42 @@
+#include <tiletwister/core/InputLatency.hpp>
+
+#include <tiletwister/core/Metrics.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+std::int64_t InputLatency::nowNs() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+bool InputLatency::presented(std::int64_t ns) {
+  if (m_pendingInputNs == 0) return false;
+  record(ns - m_pendingInputNs);
+  m_pendingInputNs = 0;
+  return true;
+}
+
+void InputLatency::record(std::int64_t latencyNs) {
+  if (latencyNs < 0) latencyNs = 0;
+  m_samples[m_next] = latencyNs;
+  m_next = (m_next + 1) % kWindow;
+  if (m_filled < kWindow) ++m_filled;
+  ++m_total;
+  metrics().inputLatencyUs.record(
+      static_cast<std::uint64_t>(latencyNs / 1000));
+}
+
+float InputLatency::percentileMs(double q) const {
+  if (m_filled == 0) return 0.0f;
+  // Nearest rank on a copy (fixed size, no allocation).
+  std::int64_t sorted[kWindow];
+  std::copy(m_samples, m_samples + m_filled, sorted);
+  q = std::min(1.0, std::max(0.0, q));
+  const int rank = std::max(
+      1, static_cast<int>(std::ceil(q * static_cast<double>(m_filled))));
+  std::nth_element(sorted, sorted + rank - 1, sorted + m_filled);
+  return static_cast<float>(sorted[rank - 1]) * 1e-6f;
+}
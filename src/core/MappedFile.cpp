@@ -0,0 +1,87 @@
+#include <tiletwister/core/MappedFile.hpp>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::~MappedFile() { close(); }
+
+#ifdef _WIN32
+
+bool MappedFile::open(const std::string& path) {
+  close();
+  HANDLE file = CreateFileA(path.c_str(), GENERIC_READ,
+                            FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr,
+                            OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+  if (file == INVALID_HANDLE_VALUE) return false;
+  LARGE_INTEGER size;
+  if (!GetFileSizeEx(file, &size)) {
+    CloseHandle(file);
+    return false;
+  }
+  m_file = file;
+  if (size.QuadPart == 0) return true;
+
+  HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  if (!mapping) {
+    close();
+    return false;
+  }
+  m_mapping = mapping;
+  const void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+  if (!view) {
+    close();
+    return false;
+  }
+  m_data = static_cast<const unsigned char*>(view);
+  m_size = static_cast<std::size_t>(size.QuadPart);
+  return true;
+}
+
+void MappedFile::close() {
+  if (m_data) UnmapViewOfFile(m_data);
+  if (m_mapping) CloseHandle(static_cast<HANDLE>(m_mapping));
+  if (m_file) CloseHandle(static_cast<HANDLE>(m_file));
+  m_data = nullptr;
+  m_size = 0;
+  m_mapping = nullptr;
+  m_file = nullptr;
+}
+
+#else
+
+bool MappedFile::open(const std::string& path) {
+  close();
+  const int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) return false;
+  struct stat st;
+  if (::fstat(fd, &st) != 0) {
+    ::close(fd);
+    return false;
+  }
+  if (st.st_size > 0) {
+    void* p = ::mmap(nullptr, static_cast<std::size_t>(st.st_size), PROT_READ,
+                     MAP_SHARED, fd, 0);
+    if (p == MAP_FAILED) {
+      ::close(fd);
+      return false;
+    }
+    m_data = static_cast<const unsigned char*>(p);
+    m_size = static_cast<std::size_t>(st.st_size);
+  }
+  ::close(fd); // the mapping stays valid
+  return true;
+}
+
+void MappedFile::close() {
+  if (m_data) ::munmap(const_cast<unsigned char*>(m_data), m_size);
+  m_data = nullptr;
+  m_size = 0;
+}
+
+#endif
@@ -0,0 +1,62 @@
+#include <tiletwister/core/Metrics.hpp>
+
+#include <cmath>
+
+int Histogram::bucketOf(std::uint64_t v) {
+  if (v < 4) return static_cast<int>(v);
+  int e = 63;
+  while (!(v >> e)) --e; // floor(log2 v), >= 2
+  const int sub = static_cast<int>((v >> (e - 2)) & 3);
+  const int b = (e - 1) * 4 + sub;
+  return b < kBuckets ? b : kBuckets - 1;
+}
+
+std::uint64_t Histogram::bucketLow(int bucket) {
+  if (bucket < 4) return static_cast<std::uint64_t>(bucket);
+  const int e = bucket / 4 + 1;
+  const std::uint64_t sub = static_cast<std::uint64_t>(bucket % 4);
+  return (4 + sub) << (e - 2);
+}
+
+Histogram::Snapshot Histogram::snapshot() const {
+  Snapshot s;
+  for (int i = 0; i < kBuckets; ++i) {
+    s.buckets[i] = m_buckets[i].load(std::memory_order_relaxed);
+    s.count += s.buckets[i];
+  }
+  s.sum = m_sum.load(std::memory_order_relaxed);
+  return s;
+}
+
+Histogram::Snapshot Histogram::Snapshot::since(const Snapshot& earlier) const {
+  Snapshot d;
+  for (int i = 0; i < kBuckets; ++i) {
+    d.buckets[i] = buckets[i] - earlier.buckets[i];
+    d.count += d.buckets[i];
+  }
+  d.sum = sum - earlier.sum;
+  return d;
+}
+
+std::uint64_t Histogram::Snapshot::quantile(double q) const {
+  if (count == 0) return 0;
+  q = q < 0.0 ? 0.0 : (q > 1.0 ? 1.0 : q);
+  // Rank of the sample at q (1-based), then the bucket that holds it.
+  std::uint64_t rank = static_cast<std::uint64_t>(std::ceil(q * count));
+  if (rank == 0) rank = 1;
+  std::uint64_t seen = 0;
+  for (int i = 0; i < kBuckets; ++i) {
+    seen += buckets[i];
+    if (seen >= rank) {
+      const std::uint64_t lo = bucketLow(i);
+      const std::uint64_t hi = i + 1 < kBuckets ? bucketLow(i + 1) : lo + 1;
+      return lo + (hi - lo - 1) / 2;
+    }
+  }
+  return bucketLow(kBuckets - 1);
+}
+
+Metrics& metrics() {
+  static Metrics instance;
+  return instance;
+}
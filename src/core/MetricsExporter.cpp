@@ -0,0 +1,204 @@
+#include <tiletwister/core/MetricsExporter.hpp>
+
+#include <tiletwister/core/AsyncFileWriter.hpp>
+#include <tiletwister/core/Trace.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <utility>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+void appendValue(std::string& out, const char* name, double v) {
+  char line[128];
+  std::snprintf(line, sizeof(line), "tiletwister_%s %.17g\n", name, v);
+  out += line;
+}
+
+void appendSummary(std::string& out, const char* name,
+                   const Histogram::Snapshot& total,
+                   const Histogram::Snapshot& window) {
+  struct Quantile {
+    const char* label;
+    double q;
+  };
+  static const Quantile kQuantiles[] = {
+      {"0.5", 0.5}, {"0.9", 0.9}, {"0.99", 0.99}, {"1", 1.0}};
+  char line[128];
+  for (const Quantile& q : kQuantiles) {
+    std::snprintf(line, sizeof(line),
+                  "tiletwister_%s{quantile=\"%s\"} %llu\n", name, q.label,
+                  static_cast<unsigned long long>(window.quantile(q.q)));
+    out += line;
+  }
+  std::snprintf(line, sizeof(line), "tiletwister_%s_count %llu\n", name,
+                static_cast<unsigned long long>(total.count));
+  out += line;
+  std::snprintf(line, sizeof(line), "tiletwister_%s_sum %llu\n", name,
+                static_cast<unsigned long long>(total.sum));
+  out += line;
+}
+
+} // namespace
+
+MetricsExporter::MetricsExporter(const Metrics& m, std::string filePath,
+                                 std::string socketPath, int intervalMs)
+    : m_metrics(m), m_filePath(std::move(filePath)),
+      m_socketPath(std::move(socketPath)),
+      m_interval(intervalMs > 0 ? intervalMs : 1000),
+      m_startTime(std::chrono::steady_clock::now()) {}
+
+MetricsExporter::~MetricsExporter() { stop(); }
+
+bool MetricsExporter::start() {
+  if (m_thread.joinable()) return true;
+  if (!openSocket()) return false;
+  m_stop = false;
+  m_thread = std::thread([this] { run(); });
+  return true;
+}
+
+void MetricsExporter::stop() {
+  if (!m_thread.joinable()) return;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stop = true;
+  }
+  m_wake.notify_all();
+  m_thread.join();
+  closeSocket();
+}
+
+std::string MetricsExporter::render() {
+  const Histogram::Snapshot frames = m_metrics.frameTimeUs.snapshot();
+  const Histogram::Snapshot saves = m_metrics.saveLatencyUs.snapshot();
+  const Histogram::Snapshot inputs = m_metrics.inputLatencyUs.snapshot();
+  const double uptime = std::chrono::duration<double>(
+                            std::chrono::steady_clock::now() - m_startTime)
+                            .count();
+
+  std::string out;
+  out.reserve(1024);
+  appendValue(out, "uptime_seconds", uptime);
+  appendValue(out, "moves_total",
+              static_cast<double>(m_metrics.moves.value()));
+  appendValue(out, "games_total",
+              static_cast<double>(m_metrics.games.value()));
+  appendValue(out, "frames_total",
+              static_cast<double>(m_metrics.frames.value()));
+  appendValue(out, "dropped_inputs_total",
+              static_cast<double>(m_metrics.droppedInputs.value()));
+  appendValue(out, "saves_total",
+              static_cast<double>(m_metrics.saves.value()));
+  appendValue(out, "save_failures_total",
+              static_cast<double>(m_metrics.saveFailures.value()));
+  appendValue(out, "score", static_cast<double>(m_metrics.score.value()));
+  appendValue(out, "best_score",
+              static_cast<double>(m_metrics.bestScore.value()));
+  appendSummary(out, "frame_time_us", frames, frames.since(m_lastFrames));
+  appendSummary(out, "save_latency_us", saves, saves.since(m_lastSaves));
+  appendSummary(out, "input_latency_us", inputs, inputs.since(m_lastInputs));
+
+  m_lastFrames = frames;
+  m_lastSaves = saves;
+  m_lastInputs = inputs;
+  return out;
+}
+
+void MetricsExporter::publish() {
+  TT_TRACE_SCOPE("MetricsExporter::publish");
+  m_published = render();
+  // Rewritten every interval: no fsync, the rename alone keeps it whole.
+  if (!m_filePath.empty()) writeFileAtomic(m_filePath, m_published, false);
+}
+
+void MetricsExporter::run() {
+  TT_TRACE_THREAD("metrics");
+  using Clock = std::chrono::steady_clock;
+  // Socket clients are picked up within this slice between publishes.
+  const auto slice = std::chrono::milliseconds(50);
+
+  publish();
+  auto next = Clock::now() + m_interval;
+  std::unique_lock<std::mutex> lock(m_mutex);
+  while (!m_stop) {
+    const auto wakeAt =
+        m_listenFd >= 0 ? std::min(next, Clock::now() + slice) : next;
+    m_wake.wait_until(lock, wakeAt, [this] { return m_stop; });
+    if (m_stop) break;
+    lock.unlock();
+
+    serveClients();
+    const auto now = Clock::now();
+    if (now >= next) {
+      publish();
+      next += m_interval;
+      if (next <= now) next = now + m_interval; // fell behind: skip ahead
+    }
+
+    lock.lock();
+  }
+}
+
+#ifdef _WIN32
+
+bool MetricsExporter::openSocket() { return m_socketPath.empty(); }
+void MetricsExporter::closeSocket() {}
+void MetricsExporter::serveClients() {}
+
+#else
+
+bool MetricsExporter::openSocket() {
+  if (m_socketPath.empty()) return true;
+  sockaddr_un addr{};
+  addr.sun_family = AF_UNIX;
+  if (m_socketPath.size() >= sizeof(addr.sun_path)) return false;
+  std::memcpy(addr.sun_path, m_socketPath.c_str(), m_socketPath.size() + 1);
+
+  const int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+  if (fd < 0) return false;
+  ::fcntl(fd, F_SETFD, FD_CLOEXEC);
+  ::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL) | O_NONBLOCK);
+  ::unlink(m_socketPath.c_str()); // stale socket from a previous run
+  const auto* sa = reinterpret_cast<const sockaddr*>(&addr);
+  if (::bind(fd, sa, sizeof(addr)) != 0 || ::listen(fd, 16) != 0) {
+    ::close(fd);
+    return false;
+  }
+  m_listenFd = fd;
+  return true;
+}
+
+void MetricsExporter::closeSocket() {
+  if (m_listenFd < 0) return;
+  ::close(m_listenFd);
+  ::unlink(m_socketPath.c_str());
+  m_listenFd = -1;
+}
+
+void MetricsExporter::serveClients() {
+  if (m_listenFd < 0) return;
+#ifdef MSG_NOSIGNAL
+  const int flags = MSG_DONTWAIT | MSG_NOSIGNAL;
+#else
+  const int flags = MSG_DONTWAIT;
+#endif
+  for (;;) {
+    const int client = ::accept(m_listenFd, nullptr, nullptr);
+    if (client < 0) return; // EAGAIN: nobody waiting
+    // The text fits the socket buffer; a client that can't take it whole
+    // right now just gets a short read.
+    ::send(client, m_published.data(), m_published.size(), flags);
+    ::close(client);
+  }
+}
+
+#endif
@@ -0,0 +1,194 @@
+#include <tiletwister/core/Trace.hpp>
+
+#if defined(TILETWISTER_ENABLE_TRACING)
+
+#include <tiletwister/core/AsyncFileWriter.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace Trace {
+namespace detail {
+namespace {
+
+struct Registry {
+  std::mutex mutex;
+  std::vector<std::unique_ptr<ThreadRing>> rings;
+  std::vector<bool> inUse;
+  std::uint32_t nextTid = 1;
+  // Reference point for converting ring timestamps to wall nanoseconds.
+  std::uint64_t tick0 = now();
+  std::chrono::steady_clock::time_point time0 =
+      std::chrono::steady_clock::now();
+};
+
+Registry& registry() {
+  static Registry r;
+  return r;
+}
+
+// Returns the ring to the pool when its thread exits.
+struct ThreadDetach {
+  ~ThreadDetach() {
+    if (!t_ring) return;
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    for (std::size_t i = 0; i < reg.rings.size(); ++i)
+      if (reg.rings[i].get() == t_ring) reg.inUse[i] = false;
+    t_ring = nullptr;
+  }
+};
+
+void appendEscaped(std::string& out, const char* s) {
+  for (; *s; ++s) {
+    if (*s == '"' || *s == '\\') out += '\\';
+    out += *s;
+  }
+}
+
+} // namespace
+
+ThreadRing* attachThread() {
+  thread_local ThreadDetach detach;
+  (void)detach;
+
+  Registry& reg = registry();
+  std::lock_guard<std::mutex> lock(reg.mutex);
+  ThreadRing* ring = nullptr;
+  for (std::size_t i = 0; i < reg.rings.size() && !ring; ++i) {
+    if (!reg.inUse[i]) {
+      // Recycled: drop the previous thread's events (export holds the same
+      // lock, so nobody is reading them).
+      ring = reg.rings[i].get();
+      ring->head.store(0, std::memory_order_relaxed);
+      ring->threadName.store(nullptr, std::memory_order_relaxed);
+      reg.inUse[i] = true;
+    }
+  }
+  if (!ring) {
+    reg.rings.push_back(std::make_unique<ThreadRing>());
+    reg.inUse.push_back(true);
+    ring = reg.rings.back().get();
+  }
+  ring->tid = reg.nextTid++;
+  t_ring = ring;
+  return ring;
+}
+
+} // namespace detail
+
+void setThreadName(const char* name) {
+  detail::ThreadRing* ring =
+      detail::t_ring ? detail::t_ring : detail::attachThread();
+  ring->threadName.store(name, std::memory_order_relaxed);
+}
+
+bool writeChromeTrace(const std::string& path) {
+  using namespace detail;
+  Registry& reg = registry();
+
+  struct Copied {
+    const char* name;
+    std::uint64_t begin;
+    std::uint64_t end;
+    std::uint32_t tid;
+  };
+  std::vector<Copied> events;
+  std::vector<std::pair<std::uint32_t, const char*>> threads;
+  double nsPerTick = 1.0;
+  std::uint64_t tick0 = 0;
+  {
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    const std::uint64_t tickNow = now();
+    const double elapsedNs =
+        std::chrono::duration<double, std::nano>(
+            std::chrono::steady_clock::now() - reg.time0)
+            .count();
+    tick0 = reg.tick0;
+    if (tickNow > reg.tick0)
+      nsPerTick = elapsedNs / static_cast<double>(tickNow - reg.tick0);
+
+    for (const auto& ringPtr : reg.rings) {
+      const ThreadRing& ring = *ringPtr;
+      if (const char* name = ring.threadName.load(std::memory_order_relaxed))
+        threads.emplace_back(ring.tid, name);
+
+      const std::uint64_t h1 = ring.head.load(std::memory_order_acquire);
+      const std::uint64_t first = h1 > kRingEvents ? h1 - kRingEvents : 0;
+      const std::size_t start = events.size();
+      for (std::uint64_t i = first; i < h1; ++i) {
+        const Event& e = ring.events[i & (kRingEvents - 1)];
+        events.push_back({e.name.load(std::memory_order_relaxed),
+                          e.begin.load(std::memory_order_relaxed),
+                          e.end.load(std::memory_order_relaxed), ring.tid});
+      }
+      // The owner kept writing while we copied: drop slots it may have
+      // overwritten meanwhile, including the one for event h2, which it may
+      // be writing now (record() publishes head only after the slot). Our
+      // own ring can't change under us.
+      std::atomic_thread_fence(std::memory_order_acquire);
+      const std::uint64_t h2 = ring.head.load(std::memory_order_relaxed);
+      const std::uint64_t unsafe = &ring == t_ring ? h2 : h2 + 1;
+      const std::uint64_t safeFrom =
+          unsafe > kRingEvents ? unsafe - kRingEvents : 0;
+      if (safeFrom > first) {
+        const std::size_t drop = static_cast<std::size_t>(
+            std::min<std::uint64_t>(safeFrom - first, h1 - first));
+        events.erase(events.begin() + start, events.begin() + start + drop);
+      }
+    }
+  }
+
+  std::uint64_t origin = tick0;
+  for (const Copied& e : events) origin = std::min(origin, e.begin);
+
+  std::string out;
+  out.reserve(events.size() * 96 + 256);
+  out += "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n";
+  bool firstLine = true;
+  char num[128];
+  for (const auto& t : threads) {
+    out += firstLine ? "" : ",\n";
+    firstLine = false;
+    std::snprintf(num, sizeof num,
+                  "{\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"name\":\"thread_name\","
+                  "\"args\":{\"name\":\"",
+                  t.first);
+    out += num;
+    appendEscaped(out, t.second);
+    out += "\"}}";
+  }
+  for (const Copied& e : events) {
+    if (!e.name) continue;
+    const double tsUs =
+        static_cast<double>(e.begin - origin) * nsPerTick / 1000.0;
+    const double durUs =
+        static_cast<double>(e.end - e.begin) * nsPerTick / 1000.0;
+    out += firstLine ? "" : ",\n";
+    firstLine = false;
+    out += "{\"ph\":\"X\",\"pid\":1,\"name\":\"";
+    appendEscaped(out, e.name);
+    std::snprintf(num, sizeof num, "\",\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+                  e.tid, tsUs, durUs);
+    out += num;
+  }
+  out += "\n]}\n";
+  return writeFileAtomic(path, out);
+}
+
+} // namespace Trace
+
+#else
+
+namespace Trace {
+
+bool writeChromeTrace(const std::string&) { return false; }
+void setThreadName(const char*) {}
+
+} // namespace Trace
+
+#endif
@@ -0,0 +1,149 @@
+#include <tiletwister/core/Tween.hpp>
+
+#include <cstddef>
+#include <cstring>
+
+namespace {
+
+constexpr std::uint32_t kNoDense = ~0u;
+
+} // namespace
+
+TweenPool::TweenPool(int capacity) {
+  const std::size_t n = capacity > 0 ? static_cast<std::size_t>(capacity) : 1;
+  for (auto* v : {&m_from0, &m_from1, &m_to0, &m_to1, &m_t, &m_invDuration,
+                  &m_value0, &m_value1, &m_prev0, &m_prev1})
+    v->reserve(n);
+  m_easing.reserve(n);
+  m_denseSlot.reserve(n);
+  m_slotDense.reserve(n);
+  m_generation.reserve(n);
+  m_freeSlots.reserve(n);
+}
+
+TweenHandle TweenPool::start(float from0, float from1, float to0, float to1,
+                             float durationSec, Easing easing) {
+  std::uint32_t slot;
+  if (!m_freeSlots.empty()) {
+    slot = m_freeSlots.back();
+    m_freeSlots.pop_back();
+  } else {
+    slot = static_cast<std::uint32_t>(m_slotDense.size());
+    m_slotDense.push_back(kNoDense);
+    m_generation.push_back(0);
+  }
+
+  const std::uint32_t dense = static_cast<std::uint32_t>(m_t.size());
+  m_from0.push_back(from0);
+  m_from1.push_back(from1);
+  m_to0.push_back(to0);
+  m_to1.push_back(to1);
+  m_t.push_back(0.0f);
+  m_invDuration.push_back(1.0f / ((durationSec <= 0.0f) ? 0.001f : durationSec));
+  m_value0.push_back(from0);
+  m_value1.push_back(from1);
+  m_prev0.push_back(from0);
+  m_prev1.push_back(from1);
+  m_easing.push_back(easing);
+  m_denseSlot.push_back(slot);
+  m_slotDense[slot] = dense;
+
+  return TweenHandle{slot, m_generation[slot]};
+}
+
+bool TweenPool::active(TweenHandle h) const {
+  return h.slot < m_slotDense.size() && m_generation[h.slot] == h.generation &&
+         m_slotDense[h.slot] != kNoDense;
+}
+
+bool TweenPool::value(TweenHandle h, float& out0, float& out1) const {
+  if (!active(h)) return false;
+  const std::uint32_t d = m_slotDense[h.slot];
+  out0 = m_value0[d];
+  out1 = m_value1[d];
+  return true;
+}
+
+bool TweenPool::sample(TweenHandle h, float alpha, float& out0,
+                       float& out1) const {
+  if (!active(h)) return false;
+  const std::uint32_t d = m_slotDense[h.slot];
+  out0 = m_prev0[d] + (m_value0[d] - m_prev0[d]) * alpha;
+  out1 = m_prev1[d] + (m_value1[d] - m_prev1[d]) * alpha;
+  return true;
+}
+
+void TweenPool::stop(TweenHandle h) {
+  if (active(h)) removeDense(m_slotDense[h.slot]);
+}
+
+void TweenPool::clear() {
+  while (!m_t.empty()) removeDense(static_cast<std::uint32_t>(m_t.size() - 1));
+}
+
+void TweenPool::removeDense(std::uint32_t dense) {
+  const std::uint32_t slot = m_denseSlot[dense];
+  const std::uint32_t last = static_cast<std::uint32_t>(m_t.size() - 1);
+  if (dense != last) {
+    // Swap-remove: move the last active tween into the hole.
+    m_from0[dense] = m_from0[last];
+    m_from1[dense] = m_from1[last];
+    m_to0[dense] = m_to0[last];
+    m_to1[dense] = m_to1[last];
+    m_t[dense] = m_t[last];
+    m_invDuration[dense] = m_invDuration[last];
+    m_value0[dense] = m_value0[last];
+    m_value1[dense] = m_value1[last];
+    m_prev0[dense] = m_prev0[last];
+    m_prev1[dense] = m_prev1[last];
+    m_easing[dense] = m_easing[last];
+    m_denseSlot[dense] = m_denseSlot[last];
+    m_slotDense[m_denseSlot[dense]] = dense;
+  }
+  for (auto* v : {&m_from0, &m_from1, &m_to0, &m_to1, &m_t, &m_invDuration,
+                  &m_value0, &m_value1, &m_prev0, &m_prev1})
+    v->pop_back();
+  m_easing.pop_back();
+  m_denseSlot.pop_back();
+
+  m_slotDense[slot] = kNoDense;
+  ++m_generation[slot];
+  m_freeSlots.push_back(slot);
+}
+
+void TweenPool::evaluate(std::uint32_t begin, std::uint32_t end) {
+  // Branch-free per element (all curves computed, one selected) so the
+  // compiler can vectorize the loop.
+  for (std::uint32_t i = begin; i < end; ++i) {
+    const float t = m_t[i] < 1.0f ? m_t[i] : 1.0f;
+    const float u = 1.0f - t;
+    const float cubic = 1.0f - u * u * u;
+    const float tri = t < 0.5f ? 2.0f * t : 2.0f * u;
+    const float v = 1.0f - tri;
+    const float pulse = 1.0f - v * v * v;
+    const Easing e = m_easing[i];
+    const float k = e == Easing::Linear ? t
+                    : e == Easing::OutCubic ? cubic
+                                            : pulse;
+    m_value0[i] = m_from0[i] + (m_to0[i] - m_from0[i]) * k;
+    m_value1[i] = m_from1[i] + (m_to1[i] - m_from1[i]) * k;
+  }
+}
+
+void TweenPool::update(float dtSec) {
+  const std::uint32_t n = static_cast<std::uint32_t>(m_t.size());
+  if (n > 0) {
+    std::memcpy(m_prev0.data(), m_value0.data(), n * sizeof(float));
+    std::memcpy(m_prev1.data(), m_value1.data(), n * sizeof(float));
+  }
+  float* t = m_t.data();
+  const float* inv = m_invDuration.data();
+  for (std::uint32_t i = 0; i < n; ++i) t[i] += dtSec * inv[i];
+
+  evaluate(0, n);
+
+  // Retire finished tweens (backwards so swap-remove doesn't skip any).
+  for (std::uint32_t i = n; i-- > 0;) {
+    if (m_t[i] >= 1.0f) removeDense(i);
+  }
+}
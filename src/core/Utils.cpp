@@ -33,6 +33,26 @@ float easeOutCubic(float t) {
   return 1.0f - u * u * u;
 }
 
+int formatInt(int value, char* out, int cap) {
+  char tmp[12];
+  int n = 0;
+  // Work with the negative magnitude so INT_MIN doesn't overflow.
+  int v = value > 0 ? -value : value;
+  do {
+    tmp[n++] = static_cast<char>('0' - (v % 10));
+    v /= 10;
+  } while (v != 0);
+  if (value < 0) tmp[n++] = '-';
+
+  if (!out || cap <= n) {
+    if (out && cap > 0) out[0] = '\0';
+    return 0;
+  }
+  for (int i = 0; i < n; ++i) out[i] = tmp[n - 1 - i];
+  out[n] = '\0';
+  return n;
+}
+
 std::vector<std::pair<int, int>> emptyCells(const int grid[4][4]) {
   std::vector<std::pair<int, int>> out;
   out.reserve(16);
@@ -0,0 +1,14 @@
+#include <tiletwister/engine/Scene.hpp>
+
+#include <SDL2/SDL.h>
+
+void Scene::handleEvent(const SDL_Event& e) {
+  m_events.dispatch(e.type, e);
+
+  // Index loop: handlers may add objects (they see events from next time).
+  const std::size_t n = m_objects.size();
+  for (std::size_t i = 0; i < n; ++i) {
+    GameObject* o = m_objects[i];
+    if (!o->m_dead) o->handleEvent(e);
+  }
+}
@@ -0,0 +1,48 @@
+#include <tiletwister/engine/System.hpp>
+
+#include <SDL2/SDL.h>
+
+#include <cmath>
+
+SpriteRenderSystem::SpriteRenderSystem(int zIndex) : m_zIndex(zIndex) {}
+
+SpriteRenderSystem::~SpriteRenderSystem() = default;
+
+void SpriteRenderSystem::render(World& world, SDL_Renderer* renderer) {
+  world.sortSpritesIfNeeded();
+
+  const ComponentArray<Sprite>& sprites = world.sprites();
+  ComponentArray<Transform>& transforms = world.transforms();
+  SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+
+  auto flush = [&](const Sprite& s) {
+    if (m_batch.empty()) return;
+    SDL_SetRenderDrawColor(renderer, s.r, s.g, s.b, s.a);
+    SDL_RenderFillRects(renderer, m_batch.data(),
+                        static_cast<int>(m_batch.size()));
+    m_batch.clear();
+  };
+
+  const Sprite* run = nullptr;
+  for (std::size_t i = 0; i < sprites.size(); ++i) {
+    const Sprite& s = sprites.data()[i];
+    const Transform* t = transforms.find(sprites.entityAt(i));
+    if (!t || s.a == 0) continue;
+
+    if (run && (run->r != s.r || run->g != s.g || run->b != s.b ||
+                run->a != s.a)) {
+      flush(*run);
+    }
+    run = &s;
+
+    const float w = t->w * t->scale;
+    const float h = t->h * t->scale;
+    SDL_Rect rect;
+    rect.x = static_cast<int>(std::lround(t->x + (t->w - w) * 0.5f));
+    rect.y = static_cast<int>(std::lround(t->y + (t->h - h) * 0.5f));
+    rect.w = static_cast<int>(std::lround(w));
+    rect.h = static_cast<int>(std::lround(h));
+    m_batch.push_back(rect);
+  }
+  if (run) flush(*run);
+}
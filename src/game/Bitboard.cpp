@@ -0,0 +1,180 @@
+#include <tiletwister/game/Bitboard.hpp>
+
+#include <tiletwister/core/Utils.hpp>
+
+#include <cmath>
+#include <vector>
+
+namespace {
+
+constexpr int kRows = 1 << 16;
+
+struct RowTables {
+  std::vector<std::uint16_t> left;  // row after moving toward column 0
+  std::vector<std::uint16_t> right; // row after moving toward column 3
+  std::vector<std::uint32_t> score; // merged values (same both ways)
+  std::vector<float> heur;          // per-row part of heuristic()
+
+  RowTables() : left(kRows), right(kRows), score(kRows), heur(kRows) {
+    for (int row = 0; row < kRows; ++row) {
+      int line[4];
+      for (int i = 0; i < 4; ++i) line[i] = (row >> (4 * i)) & 0xF;
+
+      // Evaluated on the unmoved row.
+      heur[row] = rowHeuristic(line);
+
+      // Slide + merge toward index 0 (merge once per tile).
+      int out[4] = {0, 0, 0, 0};
+      int write = 0;
+      std::uint32_t gained = 0;
+      int prev = 0;
+      for (int i = 0; i < 4; ++i) {
+        if (line[i] == 0) continue;
+        if (prev != 0 && prev == line[i] && prev < 15) {
+          out[write - 1] = prev + 1;
+          gained += 1u << (prev + 1);
+          prev = 0;
+        } else {
+          out[write++] = line[i];
+          prev = line[i];
+        }
+      }
+      const std::uint16_t moved = static_cast<std::uint16_t>(
+          out[0] | (out[1] << 4) | (out[2] << 8) | (out[3] << 12));
+      left[row] = moved;
+      score[row] = gained;
+      // Moving right is moving left on the reversed row.
+      right[reverse(static_cast<std::uint16_t>(row))] = reverse(moved);
+    }
+  }
+
+  static std::uint16_t reverse(std::uint16_t row) {
+    return static_cast<std::uint16_t>(((row & 0xF) << 12) |
+                                      ((row & 0xF0) << 4) |
+                                      ((row & 0xF00) >> 4) | (row >> 12));
+  }
+
+  static float rowHeuristic(const int line[4]) {
+    int empty = 0;
+    int merges = 0;
+    int prev = 0;
+    int run = 0;
+    float sum = 0.0f;
+    for (int i = 0; i < 4; ++i) {
+      const int e = line[i];
+      sum += std::pow(static_cast<float>(e), 3.5f);
+      if (e == 0) {
+        ++empty;
+      } else if (prev == e) {
+        ++run;
+      } else {
+        if (run > 0) merges += 1 + run;
+        run = 0;
+        prev = e;
+      }
+    }
+    if (run > 0) merges += 1 + run;
+
+    float monoLeft = 0.0f;
+    float monoRight = 0.0f;
+    for (int i = 1; i < 4; ++i) {
+      const float a = std::pow(static_cast<float>(line[i - 1]), 4.0f);
+      const float b = std::pow(static_cast<float>(line[i]), 4.0f);
+      if (line[i - 1] > line[i])
+        monoLeft += a - b;
+      else
+        monoRight += b - a;
+    }
+    return 200000.0f + 270.0f * empty + 700.0f * merges -
+           47.0f * std::fmin(monoLeft, monoRight) - 11.0f * sum;
+  }
+};
+
+const RowTables& tables() {
+  static const RowTables t;
+  return t;
+}
+
+std::uint16_t rowOf(Bitboard b, int r) {
+  return static_cast<std::uint16_t>(b >> (16 * r));
+}
+
+// Rows become columns: nibble (r, c) -> (c, r).
+Bitboard transpose(Bitboard x) {
+  const Bitboard a1 = x & 0xF0F00F0FF0F00F0Full;
+  const Bitboard a2 = x & 0x0000F0F00000F0F0ull;
+  const Bitboard a3 = x & 0x0F0F00000F0F0000ull;
+  const Bitboard a = a1 | (a2 << 12) | (a3 >> 12);
+  const Bitboard b1 = a & 0xFF00FF0000FF00FFull;
+  const Bitboard b2 = a & 0x00FF00FF00000000ull;
+  const Bitboard b3 = a & 0x00000000FF00FF00ull;
+  return b1 | (b2 >> 24) | (b3 << 24);
+}
+
+Bitboard applyRows(Bitboard b, const std::vector<std::uint16_t>& table,
+                   int* scoreGained) {
+  const RowTables& t = tables();
+  Bitboard out = 0;
+  for (int r = 0; r < 4; ++r) {
+    const std::uint16_t row = rowOf(b, r);
+    out |= static_cast<Bitboard>(table[row]) << (16 * r);
+    if (scoreGained) *scoreGained += static_cast<int>(t.score[row]);
+  }
+  return out;
+}
+
+} // namespace
+
+namespace Bitboards {
+
+Bitboard fromGrid(const int grid[4][4]) {
+  Bitboard b = 0;
+  for (int r = 0; r < 4; ++r) {
+    for (int c = 0; c < 4; ++c) {
+      int e = Utils::tileExponent(grid[r][c]);
+      if (e > 15) e = 15;
+      b = withExponent(b, r, c, e);
+    }
+  }
+  return b;
+}
+
+void toGrid(Bitboard b, int grid[4][4]) {
+  for (int r = 0; r < 4; ++r) {
+    for (int c = 0; c < 4; ++c) {
+      const int e = exponentAt(b, r, c);
+      grid[r][c] = e ? 1 << e : 0;
+    }
+  }
+}
+
+int countEmpty(Bitboard b) {
+  int n = 0;
+  for (int i = 0; i < 16; ++i) n += ((b >> (4 * i)) & 0xF) == 0;
+  return n;
+}
+
+Bitboard move(Bitboard b, Direction dir, int* scoreGained) {
+  const RowTables& t = tables();
+  switch (dir) {
+  case Direction::Left:
+    return applyRows(b, t.left, scoreGained);
+  case Direction::Right:
+    return applyRows(b, t.right, scoreGained);
+  case Direction::Up:
+    return transpose(applyRows(transpose(b), t.left, scoreGained));
+  case Direction::Down:
+    return transpose(applyRows(transpose(b), t.right, scoreGained));
+  }
+  return b;
+}
+
+float heuristic(Bitboard b) {
+  const RowTables& t = tables();
+  const Bitboard cols = transpose(b);
+  float h = 0.0f;
+  for (int r = 0; r < 4; ++r) h += t.heur[rowOf(b, r)] + t.heur[rowOf(cols, r)];
+  return h;
+}
+
+} // namespace Bitboards
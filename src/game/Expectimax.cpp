@@ -0,0 +1,125 @@
+#include <tiletwister/game/Expectimax.hpp>
+
+#include <array>
+#include <memory>
+
+namespace {
+
+constexpr float kMinProbability = 0.0001f;
+constexpr int kTableBits = 16;
+
+// Direct-mapped cache of chance-node values: (board, depth) -> value.
+struct Entry {
+  Bitboard board = 0;
+  int depth = -1;
+  float value = 0.0f;
+};
+
+struct Searcher {
+  const SearchLimits& limits;
+  Entry* table;
+  std::uint64_t nodes = 0;
+  bool stopped = false;
+  bool cancelled = false;
+
+  Searcher(const SearchLimits& l, Entry* t) : limits(l), table(t) {}
+
+  bool shouldStop() {
+    // Checked every 1024 nodes: the clock and the flag aren't free.
+    if (stopped || (++nodes & 1023) != 0) return stopped;
+    if (limits.cancel && limits.cancel->load(std::memory_order_relaxed)) {
+      cancelled = true;
+      stopped = true;
+    } else if (std::chrono::steady_clock::now() >= limits.deadline) {
+      stopped = true;
+    }
+    return stopped;
+  }
+
+  float maxNode(Bitboard b, int depth, float prob) {
+    float best = 0.0f;
+    for (const Direction d : {Direction::Left, Direction::Right,
+                              Direction::Up, Direction::Down}) {
+      const Bitboard next = Bitboards::move(b, d);
+      if (next == b) continue;
+      const float v = chanceNode(next, depth, prob);
+      if (v > best) best = v;
+      if (stopped) break;
+    }
+    return best; // 0 for a dead board
+  }
+
+  float chanceNode(Bitboard b, int depth, float prob) {
+    if (depth <= 0 || prob < kMinProbability || shouldStop())
+      return Bitboards::heuristic(b);
+
+    const std::size_t slot =
+        static_cast<std::size_t>((b * 0x9E3779B97F4A7C15ull) >>
+                                 (64 - kTableBits));
+    Entry& e = table[slot];
+    if (e.board == b && e.depth >= depth) return e.value;
+
+    const int empty = Bitboards::countEmpty(b);
+    if (empty == 0) return Bitboards::heuristic(b);
+    const float cellProb = prob / empty;
+
+    float sum = 0.0f;
+    for (int i = 0; i < 16 && !stopped; ++i) {
+      if ((b >> (4 * i)) & 0xF) continue;
+      const Bitboard two = b | (Bitboard{1} << (4 * i));
+      const Bitboard four = b | (Bitboard{2} << (4 * i));
+      sum += 0.9f * maxNode(two, depth - 1, cellProb * 0.9f) +
+             0.1f * maxNode(four, depth - 1, cellProb * 0.1f);
+    }
+    const float value = sum / empty;
+    if (!stopped) e = Entry{b, depth, value};
+    return value;
+  }
+};
+
+} // namespace
+
+struct ExpectimaxSearcher::Table {
+  std::array<Entry, 1u << kTableBits> entries{};
+};
+
+ExpectimaxSearcher::ExpectimaxSearcher() : m_table(std::make_unique<Table>()) {}
+
+ExpectimaxSearcher::~ExpectimaxSearcher() = default;
+
+SearchResult searchBestMove(Bitboard board, const SearchLimits& limits) {
+  return ExpectimaxSearcher().search(board, limits);
+}
+
+SearchResult ExpectimaxSearcher::search(Bitboard board,
+                                        const SearchLimits& limits) {
+  SearchResult result;
+  Searcher searcher(limits, m_table->entries.data());
+
+  for (int depth = 1; depth <= limits.maxDepth; ++depth) {
+    bool any = false;
+    float bestValue = -1.0f;
+    Direction bestDir = Direction::Left;
+    for (const Direction d : {Direction::Left, Direction::Right,
+                              Direction::Up, Direction::Down}) {
+      const Bitboard next = Bitboards::move(board, d);
+      if (next == board) continue;
+      const float v = searcher.chanceNode(next, depth - 1, 1.0f);
+      if (searcher.stopped) break;
+      if (!any || v > bestValue) {
+        any = true;
+        bestValue = v;
+        bestDir = d;
+      }
+    }
+    if (searcher.stopped) break; // keep the last complete depth
+    if (!any) break;              // no legal move
+    result.found = true;
+    result.dir = bestDir;
+    result.depth = depth;
+  }
+  result.cancelled = searcher.cancelled;
+  if (result.cancelled) result.found = false;
+  result.nodes = searcher.nodes;
+  return result;
+}
@@ -1,5 +1,6 @@
 #include <tiletwister/game/Game.hpp>
 
+#include <tiletwister/core/Trace.hpp>
 #include <tiletwister/core/Utils.hpp>
 
 #include <array>
@@ -14,8 +15,8 @@ struct LineItem {
 
 struct LineMoveOut {
   std::array<int, 4> values{0, 0, 0, 0};
-  std::vector<std::pair<int, int>> srcToDst; // (srcIndex -> dstIndex), per tile
-  std::vector<int> mergedDst;                // dst indices that are merge results
+  InlineVector<std::pair<int, int>, 4> srcToDst; // (srcIndex -> dstIndex)
+  InlineVector<int, 2> mergedDst; // dst indices that are merge results
   bool changed = false;
   int scoreGained = 0;
 };
@@ -24,8 +25,7 @@ struct LineMoveOut {
 // tiles are moving towards). Produces new values and a movement mapping.
 LineMoveOut moveLineForward(const std::array<int, 4>& in) {
   LineMoveOut out;
-  std::vector<LineItem> items;
-  items.reserve(4);
+  InlineVector<LineItem, 4> items;
   for (int i = 0; i < 4; ++i) {
     if (in[i] != 0) items.push_back(LineItem{in[i], i});
   }
@@ -38,14 +38,14 @@ LineMoveOut moveLineForward(const std::array<int, 4>& in) {
       // Merge: two tiles go into one cell.
       out.values[write] = items[i].value * 2;
       out.scoreGained += out.values[write];
-      out.srcToDst.emplace_back(items[i].srcIndex, write);
-      out.srcToDst.emplace_back(items[i + 1].srcIndex, write);
+      out.srcToDst.push_back({items[i].srcIndex, write});
+      out.srcToDst.push_back({items[i + 1].srcIndex, write});
       out.mergedDst.push_back(write);
       ++write;
       i += 2;
     } else {
       out.values[write] = items[i].value;
-      out.srcToDst.emplace_back(items[i].srcIndex, write);
+      out.srcToDst.push_back({items[i].srcIndex, write});
       ++write;
       i += 1;
     }
@@ -61,9 +61,17 @@ LineMoveOut moveLineForward(const std::array<int, 4>& in) {
   return out;
 }
 
+std::uint64_t seedFromGlobalRng() {
+  const std::uint64_t hi = Utils::rng()();
+  const std::uint64_t lo = Utils::rng()();
+  return (hi << 32) | lo;
+}
+
 } // namespace
 
-Game::Game() { reset(); }
+Game::Game() : Game(seedFromGlobalRng()) {}
+
+Game::Game(std::uint64_t seed) : m_rng(seed) { reset(); }
 
 void Game::clearGrid() { std::memset(m_grid, 0, sizeof(m_grid)); }
 
@@ -80,26 +88,34 @@ void Game::reset() {
   clearGrid();
   m_pendingSpawn.reset();
   m_score = 0;
+  m_moveCount = 0;
+  m_seed = m_rng.state();
   spawnInitial();
 }
 
-std::optional<std::pair<Cell, int>> Game::rollSpawn(const int grid[4][4]) const {
-  const auto empties = Utils::emptyCells(grid);
-  if (empties.empty()) return std::nullopt;
-  const int idx = Utils::randInt(0, static_cast<int>(empties.size()) - 1);
-  const int value = Utils::chance(1, 10) ? 4 : 2; // 10% 4, 90% 2
-  return std::make_pair(Cell{empties[idx].first, empties[idx].second}, value);
+std::optional<std::pair<Cell, int>> Game::rollSpawn(const int grid[4][4]) {
+  Cell empties[16];
+  int n = 0;
+  for (int r = 0; r < 4; ++r)
+    for (int c = 0; c < 4; ++c)
+      if (grid[r][c] == 0) empties[n++] = Cell{r, c};
+  if (n == 0) return std::nullopt;
+  const int idx = m_rng.below(n);
+  const int value = m_rng.chance(1, 10) ? 4 : 2; // 10% 4, 90% 2
+  return std::make_pair(empties[idx], value);
 }
 
 MoveResult Game::tryMove(Direction dir) {
+  TT_TRACE_SCOPE("Game::tryMove");
   MoveResult res;
   res.moved = false;
   res.animations.clear();
   res.mergedCells.clear();
   res.pendingSpawn.reset();
 
-  // If we still have an uncommitted spawn, don't allow moving again.
-  if (m_pendingSpawn.has_value()) return res;
+  // A spawn still pending from the previous move (its animation was cut
+  // short by buffered input): apply it first instead of refusing the move.
+  commitPendingSpawn();
 
   int outGrid[4][4]{};
   std::memset(outGrid, 0, sizeof(outGrid));
@@ -177,6 +193,7 @@ MoveResult Game::tryMove(Direction dir) {
   if (!res.moved) return res;
 
   m_score += gainedTotal;
+  ++m_moveCount;
 
   // Apply post-move grid (pre-spawn) immediately.
   std::memcpy(m_grid, outGrid, sizeof(m_grid));
@@ -218,6 +235,26 @@ bool Game::hasAnyMove(const int grid[4][4]) const {
 
 bool Game::isGameOver() const { return !hasAnyMove(m_grid); }
 
+GameState Game::state() const {
+  GameState st;
+  std::memcpy(st.grid, m_grid, sizeof(m_grid));
+  st.score = m_score;
+  st.pendingSpawn = m_pendingSpawn;
+  st.rngState = m_rng.state();
+  st.seed = m_seed;
+  st.moveCount = m_moveCount;
+  return st;
+}
+
+void Game::restore(const GameState& st) {
+  std::memcpy(m_grid, st.grid, sizeof(m_grid));
+  m_score = st.score;
+  m_pendingSpawn = st.pendingSpawn;
+  m_rng.setState(st.rngState);
+  m_seed = st.seed;
+  m_moveCount = st.moveCount;
+}
+
 void Game::setGridForTest(const int grid[4][4]) {
   std::memcpy(m_grid, grid, sizeof(m_grid));
   m_pendingSpawn.reset();
@@ -0,0 +1,320 @@
+#include <tiletwister/game/GameHistory.hpp>
+
+#include <tiletwister/core/Utils.hpp>
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+namespace {
+
+HistoryFileHeader makeHeader(const char* magic, std::uint32_t version,
+                             std::uint32_t entrySize) {
+  HistoryFileHeader h;
+  std::memcpy(h.magic, magic, 4);
+  h.version = version;
+  h.entrySize = entrySize;
+  h.blockRecords = kHistoryBlockRecords;
+  return h;
+}
+
+bool headerValid(const MappedFile& f, const char* magic,
+                 std::uint32_t version, std::uint32_t entrySize) {
+  if (f.size() < sizeof(HistoryFileHeader)) return false;
+  HistoryFileHeader h;
+  std::memcpy(&h, f.data(), sizeof(h));
+  return std::memcmp(h.magic, magic, 4) == 0 && h.version == version &&
+         h.entrySize == entrySize && h.blockRecords == kHistoryBlockRecords;
+}
+
+template <typename T>
+std::string bytesOf(const T& v) {
+  return std::string(reinterpret_cast<const char*>(&v), sizeof(v));
+}
+
+const char kLogMagic[] = "TTGH";
+const char kIndexMagic[] = "TTGI";
+
+} // namespace
+
+int historyScoreBucket(std::int32_t score) {
+  if (score < 16) return std::max(0, score);
+  int e = 4; // floor(log2(score))
+  while (e < 30 && (score >> (e + 1)) != 0) ++e;
+  return 16 * (e - 3) + ((score >> (e - 4)) & 15);
+}
+
+void accumulate(HistoryBlockSummary& s, const GameRecord& rec) {
+  ++s.count;
+  s.maxScore = std::max(s.maxScore, rec.score);
+  s.scoreSum += static_cast<std::uint64_t>(std::max(0, rec.score));
+  const int e =
+      std::min(Utils::tileExponent(rec.maxTile), kHistoryTileBuckets - 1);
+  ++s.maxTileHist[e];
+  ++s.scoreHist[historyScoreBucket(rec.score)];
+}
+
+// ---- Writer ----
+
+GameHistoryWriter::GameHistoryWriter(std::string path, AsyncFileWriter& io)
+    : m_path(std::move(path)), m_indexPath(m_path + ".idx"), m_io(io) {}
+
+void GameHistoryWriter::open() {
+  namespace fs = std::filesystem;
+  std::error_code ec;
+  m_opened = true;
+  m_count = 0;
+  m_indexBlocks = 0;
+  m_logHasHeader = false;
+  m_block = HistoryBlockSummary{};
+
+  MappedFile log;
+  if (!log.open(m_path) || log.size() == 0) {
+    // Fresh history: drop any stale index too.
+    fs::remove(m_indexPath, ec);
+    return;
+  }
+  if (!headerValid(log, kLogMagic, kHistoryVersion, sizeof(GameRecord))) {
+    // Not ours / unknown version: keep it aside and start over.
+    log.close();
+    fs::rename(m_path, m_path + ".corrupt", ec);
+    fs::remove(m_indexPath, ec);
+    return;
+  }
+
+  const std::uint64_t payload = log.size() - sizeof(HistoryFileHeader);
+  m_count = payload / sizeof(GameRecord);
+  const bool torn = payload % sizeof(GameRecord) != 0;
+  const GameRecord* recs = reinterpret_cast<const GameRecord*>(
+      log.data() + sizeof(HistoryFileHeader));
+
+  // Summaries for every complete block (index) and the current partial one.
+  const std::uint64_t complete = m_count / kHistoryBlockRecords;
+  bool indexOk = false;
+  {
+    MappedFile index;
+    if (index.open(m_indexPath) &&
+        headerValid(index, kIndexMagic, kHistoryIndexVersion,
+                    sizeof(HistoryBlockSummary))) {
+      const std::uint64_t bytes = index.size() - sizeof(HistoryFileHeader);
+      indexOk = bytes % sizeof(HistoryBlockSummary) == 0 &&
+                bytes / sizeof(HistoryBlockSummary) == complete;
+    }
+  }
+  if (!indexOk) {
+    fs::remove(m_indexPath, ec);
+    if (complete > 0) {
+      std::string rebuilt =
+          bytesOf(makeHeader(kIndexMagic, kHistoryIndexVersion,
+                             sizeof(HistoryBlockSummary)));
+      for (std::uint64_t b = 0; b < complete; ++b) {
+        HistoryBlockSummary s{};
+        for (std::uint64_t i = 0; i < kHistoryBlockRecords; ++i)
+          accumulate(s, recs[b * kHistoryBlockRecords + i]);
+        rebuilt += bytesOf(s);
+      }
+      writeFileAtomic(m_indexPath, rebuilt);
+    }
+  }
+  m_indexBlocks = complete;
+  m_logHasHeader = true;
+
+  for (std::uint64_t i = complete * kHistoryBlockRecords; i < m_count; ++i)
+    accumulate(m_block, recs[i]);
+
+  log.close();
+  if (torn) {
+    // A crash mid-append left a partial record: drop it so appends stay aligned.
+    fs::resize_file(m_path,
+                    sizeof(HistoryFileHeader) + m_count * sizeof(GameRecord), ec);
+  }
+}
+
+void GameHistoryWriter::append(const GameRecord& rec) {
+  if (!m_opened) open();
+
+  std::string bytes;
+  if (!m_logHasHeader)
+    bytes = bytesOf(makeHeader(kLogMagic, kHistoryVersion, sizeof(GameRecord)));
+  bytes += bytesOf(rec);
+  m_logHasHeader = true;
+  m_io.append(m_path, bytes);
+  ++m_count;
+
+  accumulate(m_block, rec);
+  if (m_block.count == kHistoryBlockRecords) {
+    std::string entry;
+    if (m_indexBlocks == 0)
+      entry = bytesOf(makeHeader(kIndexMagic, kHistoryIndexVersion,
+                                 sizeof(HistoryBlockSummary)));
+    entry += bytesOf(m_block);
+    m_io.append(m_indexPath, entry);
+    ++m_indexBlocks;
+    m_block = HistoryBlockSummary{};
+  }
+}
+
+// ---- Reader ----
+
+bool GameHistory::open(const std::string& path) {
+  m_records = nullptr;
+  m_count = 0;
+  m_blocks = nullptr;
+  m_indexBlocks = 0;
+  m_index.close();
+  if (!m_log.open(path)) return false;
+  if (m_log.size() == 0) return true;
+  if (!headerValid(m_log, kLogMagic, kHistoryVersion, sizeof(GameRecord))) {
+    m_log.close();
+    return false;
+  }
+  m_records = reinterpret_cast<const GameRecord*>(m_log.data() +
+                                                 sizeof(HistoryFileHeader));
+  m_count = (m_log.size() - sizeof(HistoryFileHeader)) / sizeof(GameRecord);
+
+  // The index is an optimization: use the entries that cover complete blocks
+  // and compute anything missing from the log.
+  if (m_index.open(path + ".idx") &&
+      headerValid(m_index, kIndexMagic, kHistoryIndexVersion,
+                  sizeof(HistoryBlockSummary))) {
+    m_blocks = reinterpret_cast<const HistoryBlockSummary*>(
+        m_index.data() + sizeof(HistoryFileHeader));
+    const std::uint64_t entries = (m_index.size() - sizeof(HistoryFileHeader)) /
+                                  sizeof(HistoryBlockSummary);
+    // Appends reach the log before the index, so fewer entries than
+    // complete blocks is normal; more means the index belongs to another log.
+    m_indexBlocks = entries;
+    if (entries > m_count / kHistoryBlockRecords) m_indexBlocks = 0;
+    // Every summary must also describe one full block; an index left from a
+    // copied or replaced log, or caught mid-rebuild, is ignored.
+    for (std::uint64_t b = 0; b < m_indexBlocks; ++b) {
+      const HistoryBlockSummary& s = m_blocks[b];
+      std::uint64_t scores = 0;
+      for (int i = 0; i < kHistoryScoreBuckets; ++i) scores += s.scoreHist[i];
+      if (s.count != kHistoryBlockRecords || scores != s.count) {
+        m_indexBlocks = 0;
+        break;
+      }
+    }
+    if (m_indexBlocks == 0) {
+      m_blocks = nullptr;
+      m_index.close();
+    }
+  }
+  return true;
+}
+
+GameRecord GameHistory::record(std::uint64_t i) const { return m_records[i]; }
+
+HistoryBlockSummary GameHistory::summarize(std::uint64_t begin,
+                                           std::uint64_t end) const {
+  HistoryBlockSummary s{};
+  for (std::uint64_t i = begin; i < end; ++i) accumulate(s, m_records[i]);
+  return s;
+}
+
+HistoryBlockSummary GameHistory::blockSummary(std::uint64_t block) const {
+  if (block < m_indexBlocks) return m_blocks[block];
+  const std::uint64_t begin = block * kHistoryBlockRecords;
+  return summarize(begin, std::min(m_count, begin + kHistoryBlockRecords));
+}
+
+int GameHistory::bestOfLast(std::uint64_t n) const {
+  if (m_count == 0 || n == 0) return 0;
+  const std::uint64_t begin = (n >= m_count) ? 0 : m_count - n;
+  int best = 0;
+  std::uint64_t i = begin;
+  // Leading partial block, then whole blocks via their summaries.
+  const std::uint64_t firstFull = (begin + kHistoryBlockRecords - 1) /
+                                  kHistoryBlockRecords * kHistoryBlockRecords;
+  for (; i < std::min(firstFull, m_count); ++i)
+    best = std::max(best, m_records[i].score);
+  for (; i + kHistoryBlockRecords <= m_count; i += kHistoryBlockRecords)
+    best = std::max(best, blockSummary(i / kHistoryBlockRecords).maxScore);
+  for (; i < m_count; ++i) best = std::max(best, m_records[i].score);
+  return best;
+}
+
+int GameHistory::scorePercentile(double p) const {
+  if (m_count == 0) return 0;
+  p = std::max(0.0, std::min(100.0, p));
+  const std::uint64_t target = static_cast<std::uint64_t>(
+      std::llround(p / 100.0 * static_cast<double>(m_count - 1)));
+  std::uint64_t rank = target;
+
+  const std::uint64_t blocks =
+      (m_count + kHistoryBlockRecords - 1) / kHistoryBlockRecords;
+  std::array<std::uint64_t, kHistoryScoreBuckets> hist{};
+  for (std::uint64_t b = 0; b < blocks; ++b) {
+    const HistoryBlockSummary s = blockSummary(b);
+    for (int i = 0; i < kHistoryScoreBuckets; ++i) hist[i] += s.scoreHist[i];
+  }
+  int bucket = 0;
+  while (bucket < kHistoryScoreBuckets && rank >= hist[bucket])
+    rank -= hist[bucket++];
+  // Summaries that disagree with the log: answer from the records alone.
+  if (bucket == kHistoryScoreBuckets) return scanPercentile(target);
+
+  // Exact answer: the rank-th smallest score inside that bucket, collected
+  // from the blocks that hold any.
+  std::int64_t lo = bucket;
+  std::int64_t hi = bucket + 1;
+  if (bucket >= 16) {
+    const int shift = bucket / 16 - 1;
+    lo = static_cast<std::int64_t>(16 + bucket % 16) << shift;
+    hi = lo + (std::int64_t{1} << shift);
+  }
+  if (bucket == 0) lo = INT32_MIN; // negative scores count as 0
+  std::vector<std::int32_t> scores;
+  scores.reserve(static_cast<std::size_t>(hist[bucket]));
+  for (std::uint64_t b = 0; b < blocks; ++b) {
+    std::uint32_t left = blockSummary(b).scoreHist[bucket];
+    const std::uint64_t begin = b * kHistoryBlockRecords;
+    const std::uint64_t end = std::min(m_count, begin + kHistoryBlockRecords);
+    for (std::uint64_t i = begin; left > 0 && i < end; ++i) {
+      const std::int32_t score = m_records[i].score;
+      if (score < lo || score >= hi) continue;
+      scores.push_back(score);
+      --left;
+    }
+  }
+  if (scores.size() <= rank) return scanPercentile(target);
+  const auto k = static_cast<std::ptrdiff_t>(rank);
+  std::nth_element(scores.begin(), scores.begin() + k, scores.end());
+  return scores[static_cast<std::size_t>(k)];
+}
+
+int GameHistory::scanPercentile(std::uint64_t rank) const {
+  std::vector<std::int32_t> scores(static_cast<std::size_t>(m_count));
+  for (std::uint64_t i = 0; i < m_count; ++i) scores[i] = m_records[i].score;
+  const auto k = static_cast<std::ptrdiff_t>(rank);
+  std::nth_element(scores.begin(), scores.begin() + k, scores.end());
+  return scores[static_cast<std::size_t>(k)];
+}
+
+double GameHistory::averageScore() const {
+  if (m_count == 0) return 0.0;
+  std::uint64_t sum = 0;
+  const std::uint64_t blocks =
+      (m_count + kHistoryBlockRecords - 1) / kHistoryBlockRecords;
+  for (std::uint64_t b = 0; b < blocks; ++b) sum += blockSummary(b).scoreSum;
+  return static_cast<double>(sum) / static_cast<double>(m_count);
+}
+
+std::array<std::uint64_t, kHistoryTileBuckets>
+GameHistory::maxTileHistogram() const {
+  std::array<std::uint64_t, kHistoryTileBuckets> hist{};
+  const std::uint64_t blocks =
+      (m_count + kHistoryBlockRecords - 1) / kHistoryBlockRecords;
+  for (std::uint64_t b = 0; b < blocks; ++b) {
+    const HistoryBlockSummary s = blockSummary(b);
+    for (int e = 0; e < kHistoryTileBuckets; ++e) hist[e] += s.maxTileHist[e];
+  }
+  return hist;
+}
@@ -0,0 +1,145 @@
+#include <tiletwister/game/GameWall.hpp>
+
+#include <tiletwister/core/FixedTimestep.hpp>
+#include <tiletwister/core/Metrics.hpp>
+#include <tiletwister/core/Trace.hpp>
+
+#include <algorithm>
+#include <chrono>
+
+GameWall::GameWall(int boards, int workers, const std::string& policy,
+                   int movesPerSec, std::uint64_t seed)
+    : m_movesPerSec(std::max(0, movesPerSec)) {
+  boards = std::clamp(boards, 1, WallSnapshot::kMaxBoards);
+  if (workers <= 0) {
+    const int hw = static_cast<int>(std::thread::hardware_concurrency());
+    workers = std::max(1, hw - 1);
+  }
+  workers = std::min(workers, boards);
+
+  m_games.reserve(static_cast<std::size_t>(boards));
+  for (int i = 0; i < boards; ++i) {
+    m_games.push_back(Board{Game(seed + static_cast<std::uint64_t>(i))});
+    m_games.back().game.commitPendingSpawn();
+  }
+  m_boards = std::make_unique<std::atomic<Bitboard>[]>(
+      static_cast<std::size_t>(boards));
+  for (int i = 0; i < boards; ++i) publish(i);
+
+  for (int i = 0; i < workers; ++i) {
+    auto w = std::make_unique<Worker>();
+    w->first = i * boards / workers;
+    w->last = (i + 1) * boards / workers;
+    const std::uint64_t policySeed = seed ^ (0x9E3779B97F4A7C15ull * (i + 1));
+    w->policy = makeMovePolicy(policy, policySeed);
+    if (!w->policy) w->policy = std::make_unique<ExpectimaxPolicy>();
+    m_workers.push_back(std::move(w));
+  }
+}
+
+GameWall::~GameWall() { stop(); }
+
+void GameWall::start() {
+  if (m_running.exchange(true)) return;
+  for (int i = 0; i < workerCount(); ++i)
+    m_threads.emplace_back([this, i] { run(i); });
+}
+
+void GameWall::stop() {
+  if (!m_running.exchange(false)) return;
+  for (std::thread& t : m_threads) t.join();
+  m_threads.clear();
+}
+
+void GameWall::snapshot(WallSnapshot& out) const {
+  out.boardCount = boardCount();
+  for (int i = 0; i < out.boardCount; ++i)
+    out.boards[i] = m_boards[i].load(std::memory_order_relaxed);
+}
+
+std::uint64_t GameWall::moves() const {
+  std::uint64_t n = 0;
+  for (const auto& w : m_workers) n += w->moves.load(std::memory_order_relaxed);
+  return n;
+}
+
+std::uint64_t GameWall::gamesFinished() const {
+  std::uint64_t n = 0;
+  for (const auto& w : m_workers) n += w->games.load(std::memory_order_relaxed);
+  return n;
+}
+
+void GameWall::publish(int board) {
+  m_boards[board].store(Bitboards::fromGrid(m_games[board].game.grid()),
+                        std::memory_order_relaxed);
+}
+
+void GameWall::stepWorker(int worker, float dtSec) {
+  Worker& w = *m_workers[worker];
+  std::uint64_t moves = 0;
+  std::uint64_t games = 0;
+  for (int i = w.first; i < w.last; ++i) {
+    Board& b = m_games[i];
+    if (b.game.isGameOver()) {
+      b.gameOverSec += dtSec;
+      if (b.gameOverSec < kRestartSec) continue;
+      b.gameOverSec = 0.0f;
+      b.credit = 0.0f;
+      b.game.reset();
+      b.game.commitPendingSpawn();
+      publish(i);
+      continue;
+    }
+
+    b.credit += static_cast<float>(m_movesPerSec) * dtSec;
+    bool moved = false;
+    while (b.credit >= 1.0f) {
+      b.credit -= 1.0f;
+      Direction dir;
+      if (!w.policy->chooseMove(b.game.grid(), dir) ||
+          !b.game.tryMove(dir).moved)
+        break;
+      b.game.commitPendingSpawn();
+      ++moves;
+      moved = true;
+      if (b.game.isGameOver()) {
+        ++games;
+        b.credit = 0.0f;
+        break;
+      }
+    }
+    if (moved) publish(i);
+  }
+  if (moves == 0) return;
+  w.moves.fetch_add(moves, std::memory_order_relaxed);
+  metrics().moves.add(moves);
+  if (games == 0) return;
+  w.games.fetch_add(games, std::memory_order_relaxed);
+  metrics().games.add(games);
+}
+
+void GameWall::run(int worker) {
+  TT_TRACE_THREAD("wall");
+  using Clock = std::chrono::steady_clock;
+  FixedTimestep clock(kStepSec);
+  const auto stepDuration = std::chrono::duration_cast<Clock::duration>(
+      std::chrono::duration<double>(kStepSec));
+  auto last = Clock::now();
+  auto next = last + stepDuration;
+
+  while (m_running.load(std::memory_order_acquire)) {
+    std::this_thread::sleep_until(next);
+    const auto now = Clock::now();
+    const int steps =
+        clock.advance(std::chrono::duration<double>(now - last).count());
+    last = now;
+    // Fixed schedule; after a hitch, restart it instead of bursting.
+    next += stepDuration;
+    if (next < now) next = now + stepDuration;
+
+    for (int i = 0; i < steps; ++i) {
+      TT_TRACE_SCOPE("GameWall::step");
+      stepWorker(worker, static_cast<float>(kStepSec));
+    }
+  }
+}
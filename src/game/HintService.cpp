@@ -0,0 +1,85 @@
+#include <tiletwister/game/HintService.hpp>
+
+#include <tiletwister/core/Trace.hpp>
+
+HintService::HintService(int budgetMs, int maxDepth)
+    : m_budgetMs(budgetMs > 0 ? budgetMs : 1),
+      m_maxDepth(maxDepth > 0 ? maxDepth : 1), m_thread([this] { run(); }) {}
+
+HintService::~HintService() {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stop = true;
+  }
+  m_abort.store(true, std::memory_order_relaxed);
+  m_wake.notify_one();
+  m_thread.join();
+}
+
+std::uint32_t HintService::request(const int grid[4][4]) {
+  return publishRequest(Bitboards::fromGrid(grid));
+}
+
+void HintService::cancel() { publishRequest(0); }
+
+std::uint32_t HintService::publishRequest(Bitboard board) {
+  m_board.store(board, std::memory_order_relaxed);
+  // Sequentially consistent with the worker's reset of m_abort: either it
+  // sees this id or the search it starts sees the abort.
+  const std::uint32_t id = m_requestId.fetch_add(1) + 1;
+  m_abort.store(true);
+  {
+    // Empty critical section: orders the notify after the worker's check so
+    // the wakeup can't be lost. Never contended for long (the worker only
+    // holds it to go to sleep).
+    std::lock_guard<std::mutex> lock(m_mutex);
+  }
+  m_wake.notify_one();
+  return id;
+}
+
+bool HintService::poll(Hint& out) const {
+  const std::uint64_t r = m_result.load(std::memory_order_acquire);
+  const std::uint32_t id = static_cast<std::uint32_t>(r >> 32);
+  if (r == 0 || id != m_requestId.load(std::memory_order_relaxed))
+    return false;
+  out.request = id;
+  out.depth = static_cast<int>((r >> 8) & 0xFF);
+  out.dir = static_cast<Direction>(r & 0xFF);
+  return true;
+}
+
+void HintService::run() {
+  TT_TRACE_THREAD("hints");
+  ExpectimaxSearcher searcher;
+  std::uint32_t seen = 0;
+  for (;;) {
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_wake.wait(lock, [&] {
+        return m_stop ||
+               m_requestId.load(std::memory_order_acquire) != seen;
+      });
+      if (m_stop) return;
+    }
+    seen = m_requestId.load();
+    // A request that lands after this still aborts the search below.
+    m_abort.store(false);
+    if (m_requestId.load() != seen) continue;
+    const Bitboard board = m_board.load(std::memory_order_relaxed);
+    if (board == 0) continue; // cancelled
+
+    TT_TRACE_SCOPE("HintService::search");
+    SearchLimits limits;
+    limits.deadline = std::chrono::steady_clock::now() +
+                      std::chrono::milliseconds(m_budgetMs);
+    limits.maxDepth = m_maxDepth;
+    limits.cancel = &m_abort;
+    const SearchResult res = searcher.search(board, limits);
+    if (!res.found) continue;
+    m_result.store((static_cast<std::uint64_t>(seen) << 32) |
+                       (static_cast<std::uint64_t>(res.depth) << 8) |
+                       static_cast<std::uint64_t>(res.dir),
+                   std::memory_order_release);
+  }
+}
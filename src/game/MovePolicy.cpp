@@ -0,0 +1,46 @@
+#include <tiletwister/game/MovePolicy.hpp>
+
+#include <tiletwister/game/Bitboard.hpp>
+
+bool RandomPolicy::chooseMove(const int grid[4][4], Direction& out) {
+  const Bitboard b = Bitboards::fromGrid(grid);
+  Direction legal[4];
+  int count = 0;
+  for (const Direction d : {Direction::Left, Direction::Right, Direction::Up,
+                            Direction::Down}) {
+    if (Bitboards::move(b, d) != b) legal[count++] = d;
+  }
+  if (count == 0) return false;
+  out = legal[m_rng.below(count)];
+  return true;
+}
+
+bool CornerPolicy::chooseMove(const int grid[4][4], Direction& out) {
+  const Bitboard b = Bitboards::fromGrid(grid);
+  for (const Direction d : {Direction::Down, Direction::Left,
+                            Direction::Right, Direction::Up}) {
+    if (Bitboards::move(b, d) != b) {
+      out = d;
+      return true;
+    }
+  }
+  return false;
+}
+
+bool ExpectimaxPolicy::chooseMove(const int grid[4][4], Direction& out) {
+  SearchLimits limits;
+  limits.maxDepth = m_maxDepth;
+  const SearchResult res =
+      m_searcher.search(Bitboards::fromGrid(grid), limits);
+  if (!res.found) return false;
+  out = res.dir;
+  return true;
+}
+
+std::unique_ptr<MovePolicy> makeMovePolicy(const std::string& name,
+                                           std::uint64_t seed) {
+  if (name == "random") return std::make_unique<RandomPolicy>(seed);
+  if (name == "corner") return std::make_unique<CornerPolicy>();
+  if (name == "expectimax") return std::make_unique<ExpectimaxPolicy>();
+  return nullptr;
+}
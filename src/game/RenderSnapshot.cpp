@@ -0,0 +1,27 @@
+#include <tiletwister/game/RenderSnapshot.hpp>
+
+void captureTiles(const TileStore& tiles, RenderSnapshot& out) {
+  const TweenPool& pool = tiles.tweens();
+  int count = 0;
+  for (int i = 0; i < tiles.size(); ++i) {
+    const Tile& t = tiles.tile(tiles.idAt(i));
+    if (t.value() <= 0) continue;
+
+    TileSnapshot s;
+    s.value = t.value();
+    s.exponent = t.exponent();
+    t.interpolatedPos(pool, s.row0, s.col0, 0.0f);
+    t.interpolatedPos(pool, s.row1, s.col1, 1.0f);
+    s.scale0 = t.popScale(pool, 0.0f);
+    s.scale1 = t.popScale(pool, 1.0f);
+
+    // Insertion sort by value (at most kCapacity tiles).
+    int j = count++;
+    while (j > 0 && out.tiles[j - 1].value > s.value) {
+      out.tiles[j] = out.tiles[j - 1];
+      --j;
+    }
+    out.tiles[j] = s;
+  }
+  out.tileCount = count;
+}
@@ -0,0 +1,90 @@
+#include <tiletwister/game/SaveFile.hpp>
+
+#include <cstdio>
+#include <cstring>
+
+namespace {
+
+std::uint32_t fnv1a(const void* data, std::size_t n,
+                    std::uint32_t h = 2166136261u) {
+  const unsigned char* p = static_cast<const unsigned char*>(data);
+  for (std::size_t i = 0; i < n; ++i) {
+    h ^= p[i];
+    h *= 16777619u;
+  }
+  return h;
+}
+
+std::uint32_t recordChecksum(const SaveRecord& rec) {
+  const std::uint32_t h = fnv1a(&rec, offsetof(SaveRecord, checksum));
+  if (rec.version < 2) return h;
+  return fnv1a(&rec.playedMs, sizeof(rec.playedMs), h);
+}
+
+bool isTileValue(int v) { return v == 0 || (v >= 2 && (v & (v - 1)) == 0); }
+
+} // namespace
+
+SaveRecord encodeSave(const GameState& st) {
+  SaveRecord rec;
+  std::memset(&rec, 0, sizeof(rec)); // deterministic padding for the checksum
+  std::memcpy(rec.magic, "TTSV", 4);
+  rec.version = kSaveVersion;
+  for (int r = 0; r < 4; ++r)
+    for (int c = 0; c < 4; ++c) rec.grid[r * 4 + c] = st.grid[r][c];
+  rec.score = st.score;
+  rec.spawnCell = -1;
+  if (st.pendingSpawn) {
+    rec.spawnCell = st.pendingSpawn->first.r * 4 + st.pendingSpawn->first.c;
+    rec.spawnValue = st.pendingSpawn->second;
+  }
+  rec.moveCount = st.moveCount;
+  rec.rngState = st.rngState;
+  rec.seed = st.seed;
+  rec.playedMs = st.playedMs;
+  rec.checksum = recordChecksum(rec);
+  return rec;
+}
+
+bool decodeSave(const SaveRecord& rec, GameState& out) {
+  if (std::memcmp(rec.magic, "TTSV", 4) != 0) return false;
+  if (rec.version != 1 && rec.version != kSaveVersion) return false;
+  if (rec.checksum != recordChecksum(rec)) return false;
+  if (rec.score < 0) return false;
+  for (int i = 0; i < 16; ++i)
+    if (!isTileValue(rec.grid[i])) return false;
+  if (rec.spawnCell < -1 || rec.spawnCell >= 16) return false;
+
+  GameState st;
+  for (int r = 0; r < 4; ++r)
+    for (int c = 0; c < 4; ++c) st.grid[r][c] = rec.grid[r * 4 + c];
+  st.score = rec.score;
+  if (rec.spawnCell >= 0) {
+    if (rec.spawnValue != 2 && rec.spawnValue != 4) return false;
+    // commitPendingSpawn() would overwrite whatever sits there.
+    if (rec.grid[rec.spawnCell] != 0) return false;
+    st.pendingSpawn =
+        std::make_pair(Cell{rec.spawnCell / 4, rec.spawnCell % 4}, rec.spawnValue);
+  }
+  st.moveCount = rec.moveCount;
+  st.rngState = rec.rngState;
+  st.seed = rec.seed;
+  st.playedMs = rec.version >= 2 ? rec.playedMs : 0;
+  out = st;
+  return true;
+}
+
+std::string saveBytes(const GameState& st) {
+  const SaveRecord rec = encodeSave(st);
+  return std::string(reinterpret_cast<const char*>(&rec), sizeof(rec));
+}
+
+bool loadSaveFile(const std::string& path, GameState& out) {
+  std::FILE* f = std::fopen(path.c_str(), "rb");
+  if (!f) return false;
+  SaveRecord rec;
+  const std::size_t n = std::fread(&rec, 1, sizeof(rec), f);
+  std::fclose(f);
+  if (n != sizeof(rec)) return false;
+  return decodeSave(rec, out);
+}
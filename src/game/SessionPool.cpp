@@ -0,0 +1,90 @@
+#include <tiletwister/game/SessionPool.hpp>
+
+#include <algorithm>
+
+namespace {
+
+// Game::rollSpawn on a packed board: the n-th empty cell in row-major order,
+// 4 with probability 1/10, drawn in the same order from the same Rng.
+Bitboard spawn(Bitboard b, Rng& rng) {
+  const int empty = Bitboards::countEmpty(b);
+  if (empty == 0) return b;
+  int target = rng.below(empty);
+  const int exponent = rng.chance(1, 10) ? 2 : 1;
+  for (int i = 0; i < 16; ++i) {
+    if ((b >> (4 * i)) & 0xF) continue;
+    if (target-- == 0) return b | (static_cast<Bitboard>(exponent) << (4 * i));
+  }
+  return b;
+}
+
+bool hasMove(Bitboard b) {
+  for (const Direction d : {Direction::Left, Direction::Right, Direction::Up,
+                            Direction::Down}) {
+    if (Bitboards::move(b, d) != b) return true;
+  }
+  return false;
+}
+
+std::uint32_t makeId(std::uint32_t index, std::uint8_t generation) {
+  return (static_cast<std::uint32_t>(generation) << 24) | index;
+}
+
+} // namespace
+
+SessionPool::SessionPool(std::uint32_t slots, std::uint64_t seed)
+    : m_sessions(std::min(std::max(slots, 1u), kMaxCapacity)),
+      m_seeds(seed) {
+  m_free.reserve(m_sessions.size());
+  for (std::uint32_t i = capacity(); i-- > 0;) m_free.push_back(i);
+}
+
+std::uint32_t SessionPool::create(std::uint64_t seed, std::uint32_t owner) {
+  if (m_free.empty()) return kInvalid;
+  const std::uint32_t index = m_free.back();
+  m_free.pop_back();
+
+  Session& s = m_sessions[index];
+  // Generation 0 never appears in an id, so no id is kInvalid.
+  if (++s.generation == 0) s.generation = 1;
+  Rng rng(seed != 0 ? seed : m_seeds.next());
+  s.board = spawn(spawn(0, rng), rng);
+  s.rng = rng.state();
+  s.score = 0;
+  s.moves = 0;
+  s.owner = owner;
+  s.live = true;
+  s.over = false;
+  ++m_live;
+  return makeId(index, s.generation);
+}
+
+Session* SessionPool::find(std::uint32_t id) {
+  const std::uint32_t index = id & (kMaxCapacity - 1);
+  if (index >= capacity()) return nullptr;
+  Session& s = m_sessions[index];
+  if (!s.live || makeId(index, s.generation) != id) return nullptr;
+  return &s;
+}
+
+bool SessionPool::destroy(std::uint32_t id) {
+  Session* s = find(id);
+  if (!s) return false;
+  s->live = false;
+  m_free.push_back(static_cast<std::uint32_t>(s - m_sessions.data()));
+  --m_live;
+  return true;
+}
+
+bool SessionPool::move(Session& s, Direction dir) {
+  int gained = 0;
+  const Bitboard moved = Bitboards::move(s.board, dir, &gained);
+  if (moved == s.board) return false;
+  Rng rng(s.rng);
+  s.board = spawn(moved, rng);
+  s.rng = rng.state();
+  s.score += static_cast<std::uint32_t>(gained);
+  ++s.moves;
+  s.over = !hasMove(s.board);
+  return true;
+}
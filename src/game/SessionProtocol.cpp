@@ -0,0 +1,125 @@
+#include <tiletwister/game/SessionProtocol.hpp>
+
+namespace SessionProtocol {
+
+namespace {
+
+void put32(std::uint8_t* p, std::uint32_t v) {
+  for (int i = 0; i < 4; ++i) p[i] = static_cast<std::uint8_t>(v >> (8 * i));
+}
+
+void put64(std::uint8_t* p, std::uint64_t v) {
+  for (int i = 0; i < 8; ++i) p[i] = static_cast<std::uint8_t>(v >> (8 * i));
+}
+
+std::uint32_t get32(const std::uint8_t* p) {
+  std::uint32_t v = 0;
+  for (int i = 0; i < 4; ++i) v |= static_cast<std::uint32_t>(p[i]) << (8 * i);
+  return v;
+}
+
+std::uint64_t get64(const std::uint8_t* p) {
+  std::uint64_t v = 0;
+  for (int i = 0; i < 8; ++i) v |= static_cast<std::uint64_t>(p[i]) << (8 * i);
+  return v;
+}
+
+void fillState(Response& resp, std::uint32_t id, const Session& s) {
+  resp.session = id;
+  resp.board = s.board;
+  resp.score = s.score;
+  resp.moves = s.moves;
+  if (s.over) resp.flags |= kFlagGameOver;
+}
+
+} // namespace
+
+void encodeRequest(const Request& req, std::uint8_t* out) {
+  out[0] = static_cast<std::uint8_t>(req.op);
+  out[1] = static_cast<std::uint8_t>(req.dir);
+  out[2] = 0;
+  out[3] = 0;
+  put32(out + 4, req.session);
+}
+
+bool decodeRequest(const std::uint8_t* in, Request& out) {
+  if (in[0] < static_cast<std::uint8_t>(Op::NewGame) ||
+      in[0] > static_cast<std::uint8_t>(Op::Close) || in[1] > 3)
+    return false;
+  out.op = static_cast<Op>(in[0]);
+  out.dir = static_cast<Direction>(in[1]);
+  out.session = get32(in + 4);
+  return true;
+}
+
+void encodeResponse(const Response& resp, std::uint8_t* out) {
+  out[0] = static_cast<std::uint8_t>(resp.status);
+  out[1] = static_cast<std::uint8_t>(resp.op);
+  out[2] = resp.flags;
+  out[3] = 0;
+  put32(out + 4, resp.session);
+  put64(out + 8, resp.board);
+  put32(out + 16, resp.score);
+  put32(out + 20, resp.moves);
+}
+
+void decodeResponse(const std::uint8_t* in, Response& out) {
+  out.status = static_cast<Status>(in[0]);
+  out.op = static_cast<Op>(in[1]);
+  out.flags = in[2];
+  out.session = get32(in + 4);
+  out.board = get64(in + 8);
+  out.score = get32(in + 16);
+  out.moves = get32(in + 20);
+}
+
+Response handleRequest(SessionPool& pool, std::uint32_t owner,
+                       const std::uint8_t* in, std::uint8_t* out) {
+  Response resp;
+  Request req;
+  if (!decodeRequest(in, req)) {
+    resp.status = Status::BadRequest;
+    resp.op = static_cast<Op>(in[0]);
+    encodeResponse(resp, out);
+    return resp;
+  }
+  resp.op = req.op;
+
+  if (req.op == Op::NewGame) {
+    const std::uint32_t id = pool.create(req.session, owner);
+    Session* s = pool.find(id);
+    if (s)
+      fillState(resp, id, *s);
+    else
+      resp.status = Status::PoolFull;
+    encodeResponse(resp, out);
+    return resp;
+  }
+
+  Session* s = pool.find(req.session);
+  if (!s || s->owner != owner) {
+    resp.status = Status::UnknownSession;
+    resp.session = req.session;
+    encodeResponse(resp, out);
+    return resp;
+  }
+  switch (req.op) {
+  case Op::Move:
+    if (SessionPool::move(*s, req.dir)) resp.flags |= kFlagMoved;
+    fillState(resp, req.session, *s);
+    break;
+  case Op::State:
+    fillState(resp, req.session, *s);
+    break;
+  case Op::Close:
+    fillState(resp, req.session, *s);
+    pool.destroy(req.session);
+    break;
+  case Op::NewGame:
+    break;
+  }
+  encodeResponse(resp, out);
+  return resp;
+}
+
+} // namespace SessionProtocol
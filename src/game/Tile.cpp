@@ -1,61 +1,38 @@
 #include <tiletwister/game/Tile.hpp>
 
-#include <tiletwister/core/Utils.hpp>
-
-Tile::Tile(int value, Cell cell) : m_value(value), m_cell(cell) {}
-
-void Tile::startSlide(Cell from, Cell to, float durationSec) {
-  m_slide.active = true;
-  m_slide.t = 0.0f;
-  m_slide.duration = (durationSec <= 0.0f) ? 0.001f : durationSec;
-  m_slide.from = from;
-  m_slide.to = to;
+Tile::Tile(int value, Cell cell)
+    : m_value(value), m_exponent(Utils::tileExponent(value)), m_cell(cell) {}
+
+void Tile::startSlide(TweenPool& tweens, Cell from, Cell to, float durationSec) {
+  tweens.stop(m_slide);
+  m_slide = tweens.start(static_cast<float>(from.r), static_cast<float>(from.c),
+                         static_cast<float>(to.r), static_cast<float>(to.c),
+                         durationSec, Easing::OutCubic);
   // Logical cell is where it'll land.
   m_cell = to;
 }
 
-void Tile::startPop(float durationSec) {
-  m_pop.active = true;
-  m_pop.t = 0.0f;
-  m_pop.duration = (durationSec <= 0.0f) ? 0.001f : durationSec;
+void Tile::startPop(TweenPool& tweens, float durationSec) {
+  tweens.stop(m_pop);
+  // Quick overshoot: 1 -> 1.12 -> 1 (ease out/in feel)
+  m_pop = tweens.start(1.0f, 0.0f, 1.12f, 0.0f, durationSec, Easing::Pulse);
 }
 
-void Tile::update(float dtSec) {
-  if (m_slide.active) {
-    m_slide.t += dtSec / m_slide.duration;
-    if (m_slide.t >= 1.0f) {
-      m_slide.t = 1.0f;
-      m_slide.active = false;
-    }
-  }
-  if (m_pop.active) {
-    m_pop.t += dtSec / m_pop.duration;
-    if (m_pop.t >= 1.0f) {
-      m_pop.t = 1.0f;
-      m_pop.active = false;
-    }
-  }
+void Tile::stopAnimations(TweenPool& tweens) {
+  tweens.stop(m_slide);
+  tweens.stop(m_pop);
 }
 
-void Tile::interpolatedPos(float& outRow, float& outCol) const {
-  if (!m_slide.active) {
+void Tile::interpolatedPos(const TweenPool& tweens, float& outRow,
+                           float& outCol, float alpha) const {
+  if (!tweens.sample(m_slide, alpha, outRow, outCol)) {
     outRow = static_cast<float>(m_cell.r);
     outCol = static_cast<float>(m_cell.c);
-    return;
   }
-  const float t = Utils::easeOutCubic(m_slide.t);
-  outRow = Utils::lerp(static_cast<float>(m_slide.from.r),
-                       static_cast<float>(m_slide.to.r), t);
-  outCol = Utils::lerp(static_cast<float>(m_slide.from.c),
-                       static_cast<float>(m_slide.to.c), t);
 }
 
-float Tile::popScale() const {
-  if (!m_pop.active) return 1.0f;
-  // Quick overshoot: 1 -> 1.12 -> 1 (ease out/in feel)
-  const float t = Utils::clampf(m_pop.t, 0.0f, 1.0f);
-  const float up = (t < 0.5f) ? (t / 0.5f) : ((1.0f - t) / 0.5f);
-  return 1.0f + 0.12f * Utils::easeOutCubic(up);
+float Tile::popScale(const TweenPool& tweens, float alpha) const {
+  float scale = 1.0f, unused = 0.0f;
+  tweens.sample(m_pop, alpha, scale, unused);
+  return scale;
 }
-
-
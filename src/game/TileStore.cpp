@@ -0,0 +1,138 @@
+#include <tiletwister/game/TileStore.hpp>
+
+void TileStore::clear() {
+  m_tweens.clear();
+  m_cellIndex.fill(kNone);
+  m_densePos.fill(kNone);
+  m_liveCount = 0;
+  // Hand out low ids first.
+  m_freeCount = kCapacity;
+  for (int i = 0; i < kCapacity; ++i)
+    m_free[i] = static_cast<std::int8_t>(kCapacity - 1 - i);
+
+  m_movePending = false;
+  m_consumedCount = 0;
+  m_popCount = 0;
+  m_hasSpawn = false;
+}
+
+int TileStore::allocate(int value, Cell cell) {
+  if (m_freeCount == 0) return kNone;
+  const int id = m_free[--m_freeCount];
+  m_tiles[id] = Tile(value, cell);
+  m_densePos[id] = static_cast<std::int8_t>(m_liveCount);
+  m_live[m_liveCount++] = static_cast<std::int8_t>(id);
+  return id;
+}
+
+void TileStore::release(int id) {
+  // Swap-remove from the dense list.
+  const int pos = m_densePos[id];
+  const int last = m_live[--m_liveCount];
+  m_live[pos] = static_cast<std::int8_t>(last);
+  m_densePos[last] = static_cast<std::int8_t>(pos);
+  m_densePos[id] = kNone;
+  m_tiles[id].stopAnimations(m_tweens);
+  m_free[m_freeCount++] = static_cast<std::int8_t>(id);
+}
+
+void TileStore::syncFromGrid(const int grid[4][4]) {
+  clear();
+  for (int r = 0; r < 4; ++r) {
+    for (int c = 0; c < 4; ++c) {
+      if (grid[r][c] == 0) continue;
+      m_cellIndex[r * 4 + c] =
+          static_cast<std::int8_t>(allocate(grid[r][c], Cell{r, c}));
+    }
+  }
+}
+
+void TileStore::beginMove(const MoveResult& mr, float durationSec) {
+  // A previous move that was never finished: drop its merge sources; the
+  // next finishMove resyncs anything else that is off.
+  for (int i = 0; i < m_consumedCount; ++i) release(m_consumed[i]);
+
+  std::array<std::int8_t, 16> next{};
+  next.fill(kNone);
+  m_consumedCount = 0;
+
+  auto land = [&](int id, int to) {
+    if (next[to] == kNone)
+      next[to] = static_cast<std::int8_t>(id);
+    else
+      m_consumed[m_consumedCount++] = static_cast<std::int8_t>(id);
+  };
+
+  for (const MoveAnim& a : mr.animations) {
+    const int from = a.from.r * 4 + a.from.c;
+    const int id = m_cellIndex[from];
+    if (id == kNone) continue; // out of sync: finishMove resyncs
+    m_cellIndex[from] = kNone;
+    m_tiles[id].startSlide(m_tweens, a.from, a.to, durationSec);
+    land(id, a.to.r * 4 + a.to.c);
+  }
+
+  // Tiles not referenced by any animation stay where they are.
+  for (int i = 0; i < 16; ++i) {
+    if (m_cellIndex[i] != kNone) land(m_cellIndex[i], i);
+  }
+  m_cellIndex = next;
+
+  m_popCount = 0;
+  for (const Cell& c : mr.mergedCells) {
+    if (m_popCount < static_cast<int>(m_pops.size())) m_pops[m_popCount++] = c;
+  }
+  m_hasSpawn = mr.pendingSpawn.has_value();
+  if (m_hasSpawn) m_spawnCell = mr.pendingSpawn->first;
+  m_movePending = true;
+}
+
+void TileStore::finishMove(const int grid[4][4]) {
+  if (!m_movePending) return;
+  m_movePending = false;
+
+  for (int i = 0; i < m_consumedCount; ++i) release(m_consumed[i]);
+  m_consumedCount = 0;
+
+  // No-op when the slide ran to completion; otherwise fast-forward it.
+  for (int i = 0; i < m_liveCount; ++i) m_tiles[m_live[i]].stopSlide(m_tweens);
+
+  // Pop merged destinations.
+  for (int i = 0; i < m_popCount; ++i) {
+    const Cell c = m_pops[i];
+    const int id = tileAt(c);
+    if (id == kNone) continue;
+    m_tiles[id].setValue(grid[c.r][c.c]);
+    m_tiles[id].startPop(m_tweens, 0.10f);
+  }
+  m_popCount = 0;
+
+  // Pop newly spawned tile (if any).
+  if (m_hasSpawn) {
+    const Cell c = m_spawnCell;
+    const int v = grid[c.r][c.c];
+    if (v != 0 && tileAt(c) == kNone) {
+      const int id = allocate(v, c);
+      if (id != kNone) {
+        m_cellIndex[c.r * 4 + c.c] = static_cast<std::int8_t>(id);
+        m_tiles[id].startPop(m_tweens, 0.12f);
+      }
+    }
+    m_hasSpawn = false;
+  }
+
+  if (!matchesGrid(grid)) syncFromGrid(grid);
+}
+
+bool TileStore::matchesGrid(const int grid[4][4]) const {
+  int occupied = 0;
+  for (int r = 0; r < 4; ++r) {
+    for (int c = 0; c < 4; ++c) {
+      const int id = m_cellIndex[r * 4 + c];
+      const int v = (id == kNone) ? 0 : m_tiles[id].value();
+      if (v != grid[r][c]) return false;
+      if (id != kNone) ++occupied;
+    }
+  }
+  return occupied == m_liveCount - m_consumedCount;
+}
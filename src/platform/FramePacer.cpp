@@ -0,0 +1,40 @@
+#include <tiletwister/platform/FramePacer.hpp>
+
+namespace {
+
+// Wake this early from SDL_Delay and yield the rest; covers the scheduler's
+// typical oversleep.
+constexpr double kSpinSec = 0.0015;
+
+} // namespace
+
+FramePacer::FramePacer(int maxFps) : m_freq(SDL_GetPerformanceFrequency()) {
+  setMaxFps(maxFps);
+}
+
+void FramePacer::setMaxFps(int maxFps) {
+  m_maxFps = maxFps > 0 ? maxFps : 0;
+  m_interval = m_maxFps > 0 ? m_freq / static_cast<Uint64>(m_maxFps) : 0;
+  m_next = 0;
+}
+
+void FramePacer::wait() {
+  if (m_interval == 0) return;
+
+  Uint64 now = SDL_GetPerformanceCounter();
+  if (m_next == 0) {
+    m_next = now + m_interval;
+    return;
+  }
+
+  const Uint64 spin = static_cast<Uint64>(kSpinSec * static_cast<double>(m_freq));
+  if (now + spin < m_next) {
+    const Uint64 ms = (m_next - now - spin) * 1000 / m_freq;
+    if (ms > 0) SDL_Delay(static_cast<Uint32>(ms));
+  }
+  while ((now = SDL_GetPerformanceCounter()) < m_next) SDL_Delay(0);
+
+  m_next += m_interval;
+  // More than a frame late: start a fresh schedule from now.
+  if (now > m_next) m_next = now + m_interval;
+}
@@ -0,0 +1,91 @@
+#include <tiletwister/platform/OffscreenTarget.hpp>
+
+#include <cstdlib>
+
+OffscreenTarget::~OffscreenTarget() { shutdown(); }
+
+bool OffscreenTarget::init(int w, int h) {
+  m_w = w;
+  m_h = h;
+
+  SDL_SetHint(SDL_HINT_VIDEODRIVER, "dummy");
+  if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_TIMER) != 0) {
+    return false;
+  }
+
+  m_surface =
+      SDL_CreateRGBSurfaceWithFormat(0, w, h, 32, SDL_PIXELFORMAT_ARGB8888);
+  if (!m_surface) {
+    shutdown();
+    return false;
+  }
+
+  m_renderer = SDL_CreateSoftwareRenderer(m_surface);
+  if (!m_renderer) {
+    shutdown();
+    return false;
+  }
+
+  SDL_SetRenderDrawBlendMode(m_renderer, SDL_BLENDMODE_BLEND);
+  return true;
+}
+
+void OffscreenTarget::shutdown() {
+  if (m_renderer) {
+    SDL_DestroyRenderer(m_renderer);
+    m_renderer = nullptr;
+  }
+  if (m_surface) {
+    SDL_FreeSurface(m_surface);
+    m_surface = nullptr;
+  }
+  SDL_Quit();
+}
+
+bool OffscreenTarget::saveBMP(const std::string& path) const {
+  if (!m_surface) return false;
+  return SDL_SaveBMP(m_surface, path.c_str()) == 0;
+}
+
+int OffscreenTarget::countDifferingPixels(const std::string& bmpPath,
+                                          int tolerance) const {
+  if (!m_surface) return -1;
+  SDL_Surface* loaded = SDL_LoadBMP(bmpPath.c_str());
+  if (!loaded) return -1;
+  SDL_Surface* golden =
+      SDL_ConvertSurfaceFormat(loaded, SDL_PIXELFORMAT_ARGB8888, 0);
+  SDL_FreeSurface(loaded);
+  if (!golden) return -1;
+  if (golden->w != m_w || golden->h != m_h) {
+    SDL_FreeSurface(golden);
+    return -1;
+  }
+
+  if (SDL_MUSTLOCK(m_surface)) SDL_LockSurface(m_surface);
+  if (SDL_MUSTLOCK(golden)) SDL_LockSurface(golden);
+
+  int diff = 0;
+  for (int y = 0; y < m_h; ++y) {
+    const Uint32* a = reinterpret_cast<const Uint32*>(
+        static_cast<const Uint8*>(m_surface->pixels) + y * m_surface->pitch);
+    const Uint32* b = reinterpret_cast<const Uint32*>(
+        static_cast<const Uint8*>(golden->pixels) + y * golden->pitch);
+    for (int x = 0; x < m_w; ++x) {
+      if (a[x] == b[x]) continue;
+      // Golden BMPs carry no meaningful alpha: compare RGB only.
+      for (int shift = 0; shift < 24; shift += 8) {
+        const int ca = static_cast<int>((a[x] >> shift) & 0xFF);
+        const int cb = static_cast<int>((b[x] >> shift) & 0xFF);
+        if (std::abs(ca - cb) > tolerance) {
+          ++diff;
+          break;
+        }
+      }
+    }
+  }
+
+  if (SDL_MUSTLOCK(golden)) SDL_UnlockSurface(golden);
+  if (SDL_MUSTLOCK(m_surface)) SDL_UnlockSurface(m_surface);
+  SDL_FreeSurface(golden);
+  return diff;
+}
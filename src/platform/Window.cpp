@@ -2,7 +2,7 @@
 
 Window::~Window() { shutdown(); }
 
-bool Window::init(const std::string& title, int w, int h) {
+bool Window::init(const std::string& title, int w, int h, bool vsync) {
   m_w = w;
   m_h = h;
 
@@ -17,8 +17,9 @@ bool Window::init(const std::string& title, int w, int h) {
     return false;
   }
 
-  m_renderer = SDL_CreateRenderer(
-      m_window, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC);
+  Uint32 flags = SDL_RENDERER_ACCELERATED;
+  if (vsync) flags |= SDL_RENDERER_PRESENTVSYNC;
+  m_renderer = SDL_CreateRenderer(m_window, -1, flags);
   if (!m_renderer) {
     shutdown();
     return false;
@@ -28,6 +29,12 @@ bool Window::init(const std::string& title, int w, int h) {
   return true;
 }
 
+int Window::refreshRate() const {
+  SDL_DisplayMode mode;
+  if (!m_window || SDL_GetWindowDisplayMode(m_window, &mode) != 0) return 0;
+  return mode.refresh_rate;
+}
+
 void Window::shutdown() {
   if (m_renderer) {
     SDL_DestroyRenderer(m_renderer);
@@ -1,31 +1,98 @@
 #include <tiletwister/render/Renderer.hpp>
 
-#include <tiletwister/game/Game.hpp>
-#include <tiletwister/game/Tile.hpp>
+#include <tiletwister/core/FrameStats.hpp>
+#include <tiletwister/core/InputLatency.hpp>
+#include <tiletwister/core/Trace.hpp>
+#include <tiletwister/core/Utils.hpp>
+#include <tiletwister/game/GameWall.hpp>
+#include <tiletwister/game/RenderSnapshot.hpp>
 #include <tiletwister/render/Palette.hpp>
 
 #include <algorithm>
 #include <cmath>
-#include <sstream>
+#include <cstdio>
+#include <cstring>
+#include <vector>
 
 namespace
 {
 
-  SDL_Color textColorFor(int value)
+  void setColor(SDL_Renderer *r, SDL_Color c)
   {
-    // Dark text on light tiles, white text on strong tiles.
-    if (value <= 8)
-      return SDL_Color{80, 40, 60, 255};
-    return SDL_Color{255, 255, 255, 235};
+    SDL_SetRenderDrawColor(r, c.r, c.g, c.b, c.a);
   }
 
-  void setColor(SDL_Renderer *r, SDL_Color c)
+  // Draw submissions issued by this file (rendering is single-threaded).
+  // Renderer::render reports the per-frame delta in RenderStats.
+  int g_drawCalls = 0;
+
+  void fillRect(SDL_Renderer *r, const SDL_Rect *rect)
   {
-    SDL_SetRenderDrawColor(r, c.r, c.g, c.b, c.a);
+    ++g_drawCalls;
+    SDL_RenderFillRect(r, rect);
+  }
+
+  void drawRect(SDL_Renderer *r, const SDL_Rect *rect)
+  {
+    ++g_drawCalls;
+    SDL_RenderDrawRect(r, rect);
+  }
+
+  void clear(SDL_Renderer *r)
+  {
+    ++g_drawCalls;
+    SDL_RenderClear(r);
+  }
+
+  void copy(SDL_Renderer *r, SDL_Texture *tex, const SDL_Rect *dst)
+  {
+    ++g_drawCalls;
+    SDL_RenderCopy(r, tex, nullptr, dst);
   }
 
-  // Minimal 5x7 bitmap font for the HUD labels.
-  // Only includes characters needed for "SCORE" and "BEST".
+  void copyPart(SDL_Renderer *r, SDL_Texture *tex, const SDL_Rect &src,
+                const SDL_Rect &dst)
+  {
+    ++g_drawCalls;
+    SDL_RenderCopy(r, tex, &src, &dst);
+  }
+
+  // White ARGB mask of a circle of the given radius (2r x 2r), alpha =
+  // anti-aliased coverage from 4x4 supersampling. With outline=true only a
+  // 1px ring along the circle is covered. Each quadrant is one corner.
+  std::vector<Uint32> buildCornerMask(int radius, bool outline)
+  {
+    const int size = 2 * radius;
+    const float outer = static_cast<float>(radius);
+    const float inner = outer - 1.0f;
+    const int ss = 4;
+    std::vector<Uint32> px(static_cast<size_t>(size * size));
+    for (int y = 0; y < size; ++y)
+    {
+      for (int x = 0; x < size; ++x)
+      {
+        int covered = 0;
+        for (int sy = 0; sy < ss; ++sy)
+        {
+          for (int sx = 0; sx < ss; ++sx)
+          {
+            const float fx = x + (sx + 0.5f) / ss - outer;
+            const float fy = y + (sy + 0.5f) / ss - outer;
+            const float d2 = fx * fx + fy * fy;
+            const bool in = d2 <= outer * outer &&
+                            (!outline || d2 >= inner * inner);
+            covered += in ? 1 : 0;
+          }
+        }
+        const Uint32 a = static_cast<Uint32>(covered * 255 / (ss * ss));
+        px[static_cast<size_t>(y * size + x)] = (a << 24) | 0x00FFFFFFu;
+      }
+    }
+    return px;
+  }
+
+  // Minimal 5x7 bitmap font for the HUD labels, the game-over panel and the
+  // performance overlay. Only includes the characters those need.
   const char *glyph5x7(char ch)
   {
     switch (ch)
@@ -214,6 +281,70 @@ namespace
              "00100"
              "00100"
              "01110";
+    case 'F':
+      return "11111"
+             "10000"
+             "10000"
+             "11110"
+             "10000"
+             "10000"
+             "10000";
+    case 'P':
+      return "11110"
+             "10001"
+             "10001"
+             "11110"
+             "10000"
+             "10000"
+             "10000";
+    case 'D':
+      return "11110"
+             "10001"
+             "10001"
+             "10001"
+             "10001"
+             "10001"
+             "11110";
+    case 'A':
+      return "01110"
+             "10001"
+             "10001"
+             "11111"
+             "10001"
+             "10001"
+             "10001";
+    case 'W':
+      return "10001"
+             "10001"
+             "10001"
+             "10101"
+             "10101"
+             "10101"
+             "01010";
+    case 'X':
+      return "10001"
+             "10001"
+             "01010"
+             "00100"
+             "01010"
+             "10001"
+             "10001";
+    case '-':
+      return "00000"
+             "00000"
+             "00000"
+             "11111"
+             "00000"
+             "00000"
+             "00000";
+    case '.':
+      return "00000"
+             "00000"
+             "00000"
+             "00000"
+             "00000"
+             "01100"
+             "01100";
     case '?':
       return "01110"
              "10001"
@@ -234,7 +365,7 @@ namespace
     }
   }
 
-  void drawText5x7(SDL_Renderer *r, const std::string &text, const SDL_Rect &rect,
+  void drawText5x7(SDL_Renderer *r, const char *text, const SDL_Rect &rect,
                    SDL_Color color)
   {
     setColor(r, color);
@@ -243,7 +374,7 @@ namespace
     const int gapPx = std::max(1, rect.w / 80);
     const int charGap = std::max(1, gapPx * 2);
 
-    const int n = static_cast<int>(text.size());
+    const int n = static_cast<int>(std::strlen(text));
     if (n <= 0)
       return;
 
@@ -274,15 +405,121 @@ namespace
             SDL_Rect px{x0 + i * (cols * cell + charGap) + cx * cell,
                         y0 + ry * cell,
                         cell, cell};
-            SDL_RenderFillRect(r, &px);
+            fillRect(r, &px);
           }
         }
       }
     }
   }
 
+  // Batched variant for text drawn every frame: appends the lit pixels of
+  // text (left-aligned at x, y, cell px per font pixel) to out so a whole
+  // block of text is one SDL_RenderFillRects.
+  void appendText5x7(std::vector<SDL_Rect> &out, const char *text, int x,
+                     int y, int cell)
+  {
+    for (int i = 0; text[i] != '\0'; ++i)
+    {
+      const char *g = glyph5x7(text[i]);
+      for (int ry = 0; ry < 7; ++ry)
+      {
+        for (int cx = 0; cx < 5; ++cx)
+        {
+          if (g[ry * 5 + cx] == '1')
+            out.push_back(SDL_Rect{x + cx * cell, y + ry * cell, cell, cell});
+        }
+      }
+      x += 6 * cell;
+    }
+  }
+
+  void fillRects(SDL_Renderer *r, const std::vector<SDL_Rect> &rects)
+  {
+    if (rects.empty())
+      return;
+    ++g_drawCalls;
+    SDL_RenderFillRects(r, rects.data(), static_cast<int>(rects.size()));
+  }
+
+  struct HudLayout
+  {
+    SDL_Rect area;
+    SDL_Rect scoreBox;
+    SDL_Rect bestBox;
+    SDL_Rect scoreLabel;
+    SDL_Rect bestLabel;
+    SDL_Rect scoreNum;
+    SDL_Rect bestNum;
+  };
+
+  // HUD (top area) layout, derived from the board rect.
+  HudLayout computeHudLayout(const SDL_Rect &b)
+  {
+    HudLayout h{};
+    const int hudTop = 12;
+    const int hudBottom = std::max(hudTop + 10, b.y - 12);
+    const int hudH = std::max(40, hudBottom - hudTop);
+    h.area = SDL_Rect{b.x, hudTop, b.w, hudH};
+
+    const int gap = 12;
+    const int boxW = (h.area.w - gap) / 2;
+    h.scoreBox = SDL_Rect{h.area.x, h.area.y, boxW, h.area.h};
+    h.bestBox = SDL_Rect{h.area.x + boxW + gap, h.area.y, boxW, h.area.h};
+
+    const int pad = 10;
+    const int labelH = std::max(16, h.scoreBox.h / 3);
+    // Give extra room so score digits don't look crushed.
+    const int numPad = pad + 4;
+    const int numTopGap = 6;
+
+    h.scoreLabel = SDL_Rect{h.scoreBox.x + pad, h.scoreBox.y + pad,
+                            h.scoreBox.w - 2 * pad, labelH};
+    h.bestLabel = SDL_Rect{h.bestBox.x + pad, h.bestBox.y + pad,
+                           h.bestBox.w - 2 * pad, labelH};
+    h.scoreNum = SDL_Rect{
+        h.scoreBox.x + numPad,
+        h.scoreBox.y + pad + labelH + numTopGap,
+        h.scoreBox.w - 2 * numPad,
+        h.scoreBox.h - (pad + labelH + numTopGap) - numPad,
+    };
+    h.bestNum = SDL_Rect{
+        h.bestBox.x + numPad,
+        h.bestBox.y + pad + labelH + numTopGap,
+        h.bestBox.w - 2 * numPad,
+        h.bestBox.h - (pad + labelH + numTopGap) - numPad,
+    };
+    return h;
+  }
+
+  const SDL_Color kHudTextColor{80, 40, 60, 255};
+
 } // namespace
 
+Renderer::~Renderer() { invalidateCache(); }
+
+void Renderer::invalidateCache()
+{
+  if (m_staticLayer)
+    SDL_DestroyTexture(m_staticLayer);
+  if (m_hudLayer)
+    SDL_DestroyTexture(m_hudLayer);
+  m_staticLayer = nullptr;
+  m_hudLayer = nullptr;
+  for (CornerMask &m : m_cornerMasks)
+  {
+    if (m.tex)
+      SDL_DestroyTexture(m.tex);
+    m = CornerMask{};
+  }
+  m_nextCornerMask = 0;
+  m_staticW = 0;
+  m_staticH = 0;
+  m_hudRect = SDL_Rect{0, 0, 0, 0};
+  m_hudScore = -1;
+  m_hudBest = -1;
+  m_cacheOwner = nullptr;
+}
+
 SDL_Rect Renderer::computeBoardRect(int windowW, int windowH)
 {
   // Reserve space at the top for the HUD (score/best).
@@ -317,6 +554,40 @@ SDL_Rect Renderer::computeGameOverButtonRect(int windowW, int windowH)
   return SDL_Rect{x, y, w, btnH};
 }
 
+int Renderer::computeWallColumns(int count, int windowW, int windowH)
+{
+  // Columns so that viewports come out roughly square.
+  const double aspect = static_cast<double>(std::max(1, windowW)) /
+                        static_cast<double>(std::max(1, windowH));
+  const int cols =
+      static_cast<int>(std::ceil(std::sqrt(std::max(1, count) * aspect)));
+  return std::max(1, std::min(cols, std::max(1, count)));
+}
+
+SDL_Rect Renderer::computeWallViewport(int index, int count, int windowW,
+                                       int windowH)
+{
+  const int cols = computeWallColumns(count, windowW, windowH);
+  const int rows = (std::max(1, count) + cols - 1) / cols;
+  const int c = index % cols;
+  const int rr = index / cols;
+  // Edges from integer division, so the viewports tile the window exactly.
+  const int x0 = c * windowW / cols;
+  const int x1 = (c + 1) * windowW / cols;
+  const int y0 = rr * windowH / rows;
+  const int y1 = (rr + 1) * windowH / rows;
+  return SDL_Rect{x0, y0, x1 - x0, y1 - y0};
+}
+
+SDL_Rect Renderer::computeViewportBoardRect(const SDL_Rect &viewport)
+{
+  const int side = std::min(viewport.w, viewport.h);
+  const int margin = std::max(1, side / 20);
+  const int size = std::max(4, side - 2 * margin);
+  return SDL_Rect{viewport.x + (viewport.w - size) / 2,
+                  viewport.y + (viewport.h - size) / 2, size, size};
+}
+
 SDL_Rect Renderer::boardRect(int windowW, int windowH) const
 {
   return computeBoardRect(windowW, windowH);
@@ -325,8 +596,12 @@ SDL_Rect Renderer::boardRect(int windowW, int windowH) const
 SDL_Rect Renderer::cellRect(int windowW, int windowH, float row,
                             float col) const
 {
-  const SDL_Rect b = boardRect(windowW, windowH);
-  const int gap = 12;
+  return computeCellRect(boardRect(windowW, windowH), 12, row, col);
+}
+
+SDL_Rect Renderer::computeCellRect(const SDL_Rect &b, int gap, float row,
+                                   float col)
+{
   const int cell = (b.w - gap * 5) / 4;
 
   const float px = static_cast<float>(b.x + gap) +
@@ -338,14 +613,98 @@ SDL_Rect Renderer::cellRect(int windowW, int windowH, float row,
                   static_cast<int>(std::round(py)), cell, cell};
 }
 
+SDL_Texture *Renderer::cornerMask(SDL_Renderer *r, int radius, bool outline)
+{
+  for (const CornerMask &m : m_cornerMasks)
+  {
+    if (m.tex && m.radius == radius && m.outline == outline)
+      return m.tex;
+  }
+
+  // Generated once per (radius, style); color comes from texture color/alpha
+  // modulation so every fill color shares the same mask.
+  const int size = 2 * radius;
+  SDL_Texture *tex = SDL_CreateTexture(r, SDL_PIXELFORMAT_ARGB8888,
+                                       SDL_TEXTUREACCESS_STATIC, size, size);
+  if (!tex)
+    return nullptr;
+  const std::vector<Uint32> px = buildCornerMask(radius, outline);
+  SDL_UpdateTexture(tex, nullptr, px.data(), size * 4);
+  SDL_SetTextureBlendMode(tex, SDL_BLENDMODE_BLEND);
+
+  CornerMask &slot = m_cornerMasks[m_nextCornerMask];
+  m_nextCornerMask = (m_nextCornerMask + 1) % kCornerMaskSlots;
+  if (slot.tex)
+    SDL_DestroyTexture(slot.tex);
+  slot = CornerMask{radius, outline, tex};
+  return tex;
+}
+
+void Renderer::drawCorners(SDL_Renderer *r, SDL_Texture *mask,
+                           const SDL_Rect &rect, int radius, SDL_Color color)
+{
+  SDL_SetTextureColorMod(mask, color.r, color.g, color.b);
+  SDL_SetTextureAlphaMod(mask, color.a);
+  const int rad = radius;
+  const int right = rect.x + rect.w - rad;
+  const int bottom = rect.y + rect.h - rad;
+  copyPart(r, mask, SDL_Rect{0, 0, rad, rad}, SDL_Rect{rect.x, rect.y, rad, rad});
+  copyPart(r, mask, SDL_Rect{rad, 0, rad, rad}, SDL_Rect{right, rect.y, rad, rad});
+  copyPart(r, mask, SDL_Rect{0, rad, rad, rad}, SDL_Rect{rect.x, bottom, rad, rad});
+  copyPart(r, mask, SDL_Rect{rad, rad, rad, rad}, SDL_Rect{right, bottom, rad, rad});
+}
+
 void Renderer::fillRoundRect(SDL_Renderer *r, const SDL_Rect &rect, int radius,
-                             SDL_Color color) const
+                             SDL_Color color)
 {
-  // Simple approximation: fill rect.
-  // (Keeping dependencies minimal.)
+  const int rad = std::min(radius, std::min(rect.w, rect.h) / 2);
+  SDL_Texture *mask = rad > 0 ? cornerMask(r, rad, false) : nullptr;
   setColor(r, color);
-  SDL_RenderFillRect(r, &rect);
-  (void)radius;
+  if (!mask)
+  {
+    fillRect(r, &rect);
+    return;
+  }
+
+  // 9-slice: 4 cached corner blits + 3 non-overlapping bands (so translucent
+  // colors don't double-blend).
+  drawCorners(r, mask, rect, rad, color);
+  const SDL_Rect top{rect.x + rad, rect.y, rect.w - 2 * rad, rad};
+  const SDL_Rect mid{rect.x, rect.y + rad, rect.w, rect.h - 2 * rad};
+  const SDL_Rect bot{rect.x + rad, rect.y + rect.h - rad, rect.w - 2 * rad, rad};
+  if (top.w > 0)
+  {
+    fillRect(r, &top);
+    fillRect(r, &bot);
+  }
+  if (mid.h > 0)
+    fillRect(r, &mid);
+}
+
+void Renderer::strokeRoundRect(SDL_Renderer *r, const SDL_Rect &rect,
+                               int radius, SDL_Color color)
+{
+  const int rad = std::min(radius, std::min(rect.w, rect.h) / 2);
+  SDL_Texture *mask = rad > 0 ? cornerMask(r, rad, true) : nullptr;
+  setColor(r, color);
+  if (!mask)
+  {
+    drawRect(r, &rect);
+    return;
+  }
+
+  drawCorners(r, mask, rect, rad, color);
+  const SDL_Rect edges[4] = {
+      {rect.x + rad, rect.y, rect.w - 2 * rad, 1},
+      {rect.x + rad, rect.y + rect.h - 1, rect.w - 2 * rad, 1},
+      {rect.x, rect.y + rad, 1, rect.h - 2 * rad},
+      {rect.x + rect.w - 1, rect.y + rad, 1, rect.h - 2 * rad},
+  };
+  for (const SDL_Rect &e : edges)
+  {
+    if (e.w > 0 && e.h > 0)
+      fillRect(r, &e);
+  }
 }
 
 void Renderer::drawDigit(SDL_Renderer *r, int digit, int x, int y, int w, int h,
@@ -407,7 +766,7 @@ void Renderer::drawDigit(SDL_Renderer *r, int digit, int x, int y, int w, int h,
     if (mask & bit)
     {
       SDL_Rect rr = segRect(seg);
-      SDL_RenderFillRect(r, &rr);
+      fillRect(r, &rr);
     }
   };
 
@@ -420,105 +779,81 @@ void Renderer::drawDigit(SDL_Renderer *r, int digit, int x, int y, int w, int h,
   drawIf('g', 1 << 0);
 }
 
-void Renderer::drawNumber(SDL_Renderer *r, const SDL_Rect &rect,
-                          int value) const
+const Renderer::NumberLayout &Renderer::numberLayout(int value, int w,
+                                                     int h)
 {
-  if (value <= 0)
-    return;
+  // Direct-mapped cache: tile sizes are fixed per window size, so the working
+  // set is the handful of values currently on the board.
+  const unsigned hash = static_cast<unsigned>(value) * 2654435761u ^
+                        static_cast<unsigned>(w) * 40503u ^
+                        static_cast<unsigned>(h);
+  NumberLayout &L = m_numberLayouts[hash % kNumberLayoutSlots];
+  if (L.value == value && L.w == w && L.h == h)
+    return L;
 
-  std::ostringstream ss;
-  ss << value;
-  const std::string s = ss.str();
+  L.value = value;
+  L.w = w;
+  L.h = h;
 
-  const SDL_Color color = textColorFor(value);
+  char s[12];
+  const int digits = Utils::formatInt(value, s, sizeof(s));
+  L.count = digits;
 
   // Fit digits inside rect with explicit padding so numbers never overflow.
-  const int digits = static_cast<int>(s.size());
-  const int pad = std::max(6, rect.w / 10);
-  const int availW = std::max(1, rect.w - 2 * pad);
-  const int availH = std::max(1, rect.h - 2 * pad);
+  const int pad = std::max(6, w / 10);
+  const int availW = std::max(1, w - 2 * pad);
+  const int availH = std::max(1, h - 2 * pad);
 
   // Gap between digits scales down for narrow layouts.
   const int gap = std::max(2, availW / 40);
 
   // Compute digit width so the whole string fits horizontally.
-  const int digitW = std::max(6, (availW - gap * (digits - 1)) / digits);
+  L.digitW = std::max(6, (availW - gap * (digits - 1)) / digits);
 
   // Height: keep a 7-seg aspect (roughly 2:1), but clamp to available height.
-  const int digitH = std::max(10, std::min(availH, digitW * 2));
+  L.digitH = std::max(10, std::min(availH, L.digitW * 2));
 
-  const int totalW = digitW * digits + gap * (digits - 1);
-  int x = rect.x + (rect.w - totalW) / 2;
-  const int y = rect.y + (rect.h - digitH) / 2;
+  const int totalW = L.digitW * digits + gap * (digits - 1);
+  int x = (w - totalW) / 2;
+  L.y = (h - L.digitH) / 2;
 
-  for (char ch : s)
+  for (int i = 0; i < digits; ++i)
   {
-    const int d = ch - '0';
-    drawDigit(r, d, x, y, digitW, digitH, color);
-    x += digitW + gap;
+    L.digit[i] = static_cast<Uint8>(s[i] - '0');
+    L.x[i] = x;
+    x += L.digitW + gap;
   }
+  return L;
 }
 
-void Renderer::render(SDL_Renderer *r, const Game &game,
-                      const std::unordered_map<int, Tile> &tiles, int windowW,
-                      int windowH, int score, int bestScore, bool gameOver,
-                      bool gameOverButtonHover)
+void Renderer::drawNumber(SDL_Renderer *r, const SDL_Rect &rect, int value,
+                          SDL_Color color)
+{
+  if (value <= 0)
+    return;
+
+  const NumberLayout &L = numberLayout(value, rect.w, rect.h);
+  for (int i = 0; i < L.count; ++i)
+    drawDigit(r, L.digit[i], rect.x + L.x[i], rect.y + L.y, L.digitW,
+              L.digitH, color);
+}
+
+void Renderer::drawStaticLayer(SDL_Renderer *r, int windowW, int windowH)
 {
-  (void)game;
   // Background
   setColor(r, Palette::backgroundPink());
-  SDL_RenderClear(r);
+  clear(r);
 
-  // Board base
   const SDL_Rect b = boardRect(windowW, windowH);
 
-  // HUD (top area)
-  {
-    const int hudTop = 12;
-    const int hudBottom = std::max(hudTop + 10, b.y - 12);
-    const int hudH = std::max(40, hudBottom - hudTop);
-    const SDL_Rect hudArea{b.x, hudTop, b.w, hudH};
-
-    const int gap = 12;
-    const int boxW = (hudArea.w - gap) / 2;
-    const SDL_Rect scoreBox{hudArea.x, hudArea.y, boxW, hudArea.h};
-    const SDL_Rect bestBox{hudArea.x + boxW + gap, hudArea.y, boxW, hudArea.h};
-
-    fillRoundRect(r, scoreBox, 12, SDL_Color{255, 255, 255, 45});
-    fillRoundRect(r, bestBox, 12, SDL_Color{255, 255, 255, 45});
-
-    const int pad = 10;
-    const int labelH = std::max(16, scoreBox.h / 3);
-    // Give extra room so score digits don't look crushed.
-    const int numPad = pad + 4;
-    const int numTopGap = 6;
-
-    SDL_Rect scoreLabel{scoreBox.x + pad, scoreBox.y + pad,
-                        scoreBox.w - 2 * pad, labelH};
-    SDL_Rect bestLabel{bestBox.x + pad, bestBox.y + pad,
-                       bestBox.w - 2 * pad, labelH};
-    SDL_Rect scoreNum{
-        scoreBox.x + numPad,
-        scoreBox.y + pad + labelH + numTopGap,
-        scoreBox.w - 2 * numPad,
-        scoreBox.h - (pad + labelH + numTopGap) - numPad,
-    };
-    SDL_Rect bestNum{
-        bestBox.x + numPad,
-        bestBox.y + pad + labelH + numTopGap,
-        bestBox.w - 2 * numPad,
-        bestBox.h - (pad + labelH + numTopGap) - numPad,
-    };
-
-    const SDL_Color labelColor{80, 40, 60, 255};
-    drawText5x7(r, "SCORE", scoreLabel, labelColor);
-    drawText5x7(r, "BEST", bestLabel, labelColor);
-
-    // HUD numbers: square pixel font so they stay readable and compact.
-    drawText5x7(r, std::to_string(score), scoreNum, labelColor);
-    drawText5x7(r, std::to_string(bestScore), bestNum, labelColor);
-  }
+  // HUD boxes + labels (numbers are drawn separately, see drawHudNumbers)
+  const HudLayout hud = computeHudLayout(b);
+  fillRoundRect(r, hud.scoreBox, 12, SDL_Color{255, 255, 255, 45});
+  fillRoundRect(r, hud.bestBox, 12, SDL_Color{255, 255, 255, 45});
+  drawText5x7(r, "SCORE", hud.scoreLabel, kHudTextColor);
+  drawText5x7(r, "BEST", hud.bestLabel, kHudTextColor);
 
+  // Board base
   fillRoundRect(r, b, 16, SDL_Color{255, 255, 255, 35});
 
   // Empty cells
@@ -531,53 +866,223 @@ void Renderer::render(SDL_Renderer *r, const Game &game,
       fillRoundRect(r, cell, 12, Palette::gridEmptyCellColor());
     }
   }
+}
+
+void Renderer::drawHudNumbers(SDL_Renderer *r, int windowW, int windowH,
+                              int score, int bestScore, int offsetX,
+                              int offsetY) const
+{
+  const HudLayout hud = computeHudLayout(boardRect(windowW, windowH));
+  SDL_Rect scoreNum = hud.scoreNum;
+  SDL_Rect bestNum = hud.bestNum;
+  scoreNum.x += offsetX;
+  scoreNum.y += offsetY;
+  bestNum.x += offsetX;
+  bestNum.y += offsetY;
 
-  // Tiles
-  // Draw in value order so larger tiles appear on top (helps pop look).
-  std::vector<const Tile *> drawList;
-  drawList.reserve(tiles.size());
-  for (const auto &kv : tiles)
-    drawList.push_back(&kv.second);
-  std::sort(drawList.begin(), drawList.end(),
-            [](const Tile *a, const Tile *b)
-            { return a->value() < b->value(); });
+  // HUD numbers: square pixel font so they stay readable and compact.
+  char buf[12];
+  Utils::formatInt(score, buf, sizeof(buf));
+  drawText5x7(r, buf, scoreNum, kHudTextColor);
+  Utils::formatInt(bestScore, buf, sizeof(buf));
+  drawText5x7(r, buf, bestNum, kHudTextColor);
+}
 
-  for (const Tile *t : drawList)
+bool Renderer::ensureStaticLayer(SDL_Renderer *r, int windowW, int windowH)
+{
+  if (m_cacheOwner != r)
   {
-    if (t->value() <= 0)
-      continue;
+    invalidateCache();
+    m_cacheOwner = r;
+  }
+  if (m_staticLayer && m_staticW == windowW && m_staticH == windowH)
+    return true;
+
+  if (m_staticLayer)
+  {
+    SDL_DestroyTexture(m_staticLayer);
+    m_staticLayer = nullptr;
+  }
+  if (!SDL_RenderTargetSupported(r))
+    return false;
+
+  m_staticLayer = SDL_CreateTexture(r, SDL_PIXELFORMAT_RGBA8888,
+                                    SDL_TEXTUREACCESS_TARGET, windowW, windowH);
+  if (!m_staticLayer)
+    return false;
+  m_staticW = windowW;
+  m_staticH = windowH;
+
+  // The layer is fully opaque: copy it without blending.
+  SDL_SetTextureBlendMode(m_staticLayer, SDL_BLENDMODE_NONE);
+
+  SDL_Texture *prevTarget = SDL_GetRenderTarget(r);
+  SDL_SetRenderTarget(r, m_staticLayer);
+  drawStaticLayer(r, windowW, windowH);
+  SDL_SetRenderTarget(r, prevTarget);
+  return true;
+}
+
+bool Renderer::ensureHudLayer(SDL_Renderer *r, int windowW, int windowH,
+                              int score, int bestScore)
+{
+  const HudLayout hud = computeHudLayout(boardRect(windowW, windowH));
+  const bool sameRect = m_hudRect.x == hud.area.x && m_hudRect.y == hud.area.y &&
+                        m_hudRect.w == hud.area.w && m_hudRect.h == hud.area.h;
+  if (m_hudLayer && sameRect && m_hudScore == score && m_hudBest == bestScore)
+    return true;
+
+  if (m_hudLayer && !sameRect)
+  {
+    SDL_DestroyTexture(m_hudLayer);
+    m_hudLayer = nullptr;
+  }
+  if (!m_hudLayer)
+  {
+    m_hudLayer = SDL_CreateTexture(r, SDL_PIXELFORMAT_RGBA8888,
+                                   SDL_TEXTUREACCESS_TARGET, hud.area.w,
+                                   hud.area.h);
+    if (!m_hudLayer)
+      return false;
+    SDL_SetTextureBlendMode(m_hudLayer, SDL_BLENDMODE_BLEND);
+    m_hudRect = hud.area;
+  }
 
-    float row = 0.0f, col = 0.0f;
-    t->interpolatedPos(row, col);
-    SDL_Rect base = cellRect(windowW, windowH, row, col);
+  SDL_Texture *prevTarget = SDL_GetRenderTarget(r);
+  SDL_SetRenderTarget(r, m_hudLayer);
+  setColor(r, SDL_Color{0, 0, 0, 0});
+  clear(r);
+  drawHudNumbers(r, windowW, windowH, score, bestScore, -hud.area.x,
+                 -hud.area.y);
+  SDL_SetRenderTarget(r, prevTarget);
 
-    const float scale = t->popScale();
-    SDL_Rect rect = base;
-    if (scale != 1.0f)
+  m_hudScore = score;
+  m_hudBest = bestScore;
+  return true;
+}
+
+void Renderer::drawHintArrow(SDL_Renderer *r, const SDL_Rect &board,
+                             Direction dir)
+{
+  // Built along +u (the move direction) around the board center, then
+  // mapped onto x/y: a shaft and a head of scanlines narrowing to the tip.
+  const int half = std::min(board.w, board.h) * 3 / 10;
+  const int shaft = std::max(4, half / 6);
+  const int headLen = half * 2 / 3;
+  const int headHalf = half / 2;
+  const int step = std::max(2, half / 40);
+  const int cx = board.x + board.w / 2;
+  const int cy = board.y + board.h / 2;
+
+  std::vector<SDL_Rect> &batch = m_overlayRects;
+  batch.clear();
+  auto push = [&](int u0, int u1, int v0, int v1) {
+    switch (dir)
     {
-      const int cx = base.x + base.w / 2;
-      const int cy = base.y + base.h / 2;
-      rect.w = static_cast<int>(std::round(base.w * scale));
-      rect.h = static_cast<int>(std::round(base.h * scale));
-      rect.x = cx - rect.w / 2;
-      rect.y = cy - rect.h / 2;
+    case Direction::Right:
+      batch.push_back(SDL_Rect{cx + u0, cy + v0, u1 - u0, v1 - v0});
+      break;
+    case Direction::Left:
+      batch.push_back(SDL_Rect{cx - u1, cy + v0, u1 - u0, v1 - v0});
+      break;
+    case Direction::Down:
+      batch.push_back(SDL_Rect{cx + v0, cy + u0, v1 - v0, u1 - u0});
+      break;
+    case Direction::Up:
+      batch.push_back(SDL_Rect{cx + v0, cy - u1, v1 - v0, u1 - u0});
+      break;
     }
+  };
+
+  const int headStart = half - headLen;
+  push(-half, headStart, -shaft / 2, shaft - shaft / 2);
+  for (int u = headStart; u < half; u += step)
+  {
+    const int w = headHalf * (half - u) / headLen;
+    if (w > 0)
+      push(u, std::min(u + step, half), -w, w);
+  }
+
+  setColor(r, SDL_Color{255, 255, 255, 150});
+  fillRects(r, batch);
+}
 
-    fillRoundRect(r, rect, 12, Palette::tileColor(t->value()));
+void Renderer::render(SDL_Renderer *r, const RenderSnapshot &frame,
+                      float alpha, int windowW, int windowH,
+                      bool gameOverButtonHover)
+{
+  const int drawCallsBefore = g_drawCalls;
+  m_stats = RenderStats{};
+  const SDL_Rect b = boardRect(windowW, windowH);
+  const int score = frame.score;
+  const int bestScore = frame.bestScore;
+  const bool gameOver = frame.gameOver;
 
-    // Border
-    setColor(r, Palette::tileBorderColor());
-    SDL_RenderDrawRect(r, &rect);
+  TT_TRACE_SCOPE("Renderer::render");
 
-    drawNumber(r, rect, t->value());
+  // Static layers: one copy when render targets are available, otherwise
+  // draw them directly (same output, just slower).
+  bool cached = false;
+  {
+    TT_TRACE_SCOPE("Renderer::cells");
+    cached = ensureStaticLayer(r, windowW, windowH);
+    if (cached)
+      copy(r, m_staticLayer, nullptr);
+    else
+      drawStaticLayer(r, windowW, windowH);
+  }
+  {
+    TT_TRACE_SCOPE("Renderer::hud");
+    if (cached && ensureHudLayer(r, windowW, windowH, score, bestScore))
+      copy(r, m_hudLayer, &m_hudRect);
+    else
+      drawHudNumbers(r, windowW, windowH, score, bestScore, 0, 0);
   }
 
+  // Tiles (already in draw order: larger values on top, helps pop look).
+  alpha = std::min(1.0f, std::max(0.0f, alpha));
+  {
+    TT_TRACE_SCOPE("Renderer::tiles");
+    for (int i = 0; i < frame.tileCount; ++i)
+    {
+      const TileSnapshot &t = frame.tiles[i];
+      const float row = t.row0 + (t.row1 - t.row0) * alpha;
+      const float col = t.col0 + (t.col1 - t.col0) * alpha;
+      SDL_Rect base = cellRect(windowW, windowH, row, col);
+
+      const float scale = t.scale0 + (t.scale1 - t.scale0) * alpha;
+      SDL_Rect rect = base;
+      if (scale != 1.0f)
+      {
+        const int cx = base.x + base.w / 2;
+        const int cy = base.y + base.h / 2;
+        rect.w = static_cast<int>(std::round(base.w * scale));
+        rect.h = static_cast<int>(std::round(base.h * scale));
+        rect.x = cx - rect.w / 2;
+        rect.y = cy - rect.h / 2;
+      }
+
+      const int exponent = std::min(t.exponent, Palette::kMaxTileExponent);
+      fillRoundRect(r, rect, 12, Palette::tileColorByExponent(exponent));
+
+      // Border
+      strokeRoundRect(r, rect, 12, Palette::tileBorderColor());
+
+      drawNumber(r, rect, t.value, Palette::tileTextColorByExponent(exponent));
+      ++m_stats.tilesDrawn;
+    }
+  }
+
+  if (frame.hintShown && !gameOver)
+    drawHintArrow(r, b, frame.hintDir);
+
   if (gameOver)
   {
+    TT_TRACE_SCOPE("Renderer::overlay");
     // Dim the board and show a centered "window" with restart button.
     // Less transparent overlay for better readability.
     setColor(r, SDL_Color{0, 0, 0, 170});
-    SDL_RenderFillRect(r, &b);
+    fillRect(r, &b);
 
     const SDL_Rect panel = computeGameOverPanelRect(windowW, windowH);
     fillRoundRect(r, panel, 14, SDL_Color{255, 255, 255, 210});
@@ -598,12 +1103,183 @@ void Renderer::render(SDL_Renderer *r, const Game &game,
     const SDL_Color btnFill = gameOverButtonHover ? SDL_Color{255, 255, 255, 255}
                                                   : SDL_Color{255, 255, 255, 235};
     fillRoundRect(r, btn, 12, btnFill);
-    setColor(r, SDL_Color{80, 40, 60, 80});
-    SDL_RenderDrawRect(r, &btn);
+    strokeRoundRect(r, btn, 12, SDL_Color{80, 40, 60, 80});
 
     SDL_Rect btnText{btn.x + 10, btn.y + 6, btn.w - 20, btn.h - 12};
     drawText5x7(r, "RECOMMENCER ?", btnText, msgColor);
   }
 
-  SDL_RenderPresent(r);
+  m_stats.drawCalls = g_drawCalls - drawCallsBefore;
+}
+
+void Renderer::renderWall(SDL_Renderer *r, const WallSnapshot &wall,
+                          int windowW, int windowH)
+{
+  TT_TRACE_SCOPE("Renderer::wall");
+  const int drawCallsBefore = g_drawCalls;
+  m_stats = RenderStats{};
+
+  m_wallBases.clear();
+  m_wallCells.clear();
+  for (auto &batch : m_wallTiles)
+    batch.clear();
+  for (auto &batch : m_wallText)
+    batch.clear();
+
+  for (int i = 0; i < wall.boardCount; ++i)
+  {
+    const SDL_Rect vp = computeWallViewport(i, wall.boardCount, windowW,
+                                            windowH);
+    const SDL_Rect b = computeViewportBoardRect(vp);
+    // Same proportions as the single board (12 px gaps at ~430 px).
+    const int gap = std::max(1, b.w / 36);
+    m_wallBases.push_back(b);
+
+    const Bitboard board = wall.boards[i];
+    for (int cell = 0; cell < 16; ++cell)
+    {
+      const SDL_Rect rect =
+          computeCellRect(b, gap, static_cast<float>(cell / 4),
+                          static_cast<float>(cell % 4));
+      const int exponent =
+          std::min(Bitboards::exponentAt(board, cell / 4, cell % 4),
+                   Palette::kMaxTileExponent);
+      if (exponent == 0)
+      {
+        m_wallCells.push_back(rect);
+        continue;
+      }
+      m_wallTiles[exponent].push_back(rect);
+      ++m_stats.tilesDrawn;
+
+      // Centered digits, as large as fit in ~60% of the cell.
+      char digits[12];
+      const int len = Utils::formatInt(1 << exponent, digits, sizeof(digits));
+      const int px = std::min(rect.w * 3 / (5 * (6 * len - 1)), rect.h / 14);
+      if (px < 1)
+        continue;
+      const int textW = (6 * len - 1) * px;
+      appendText5x7(m_wallText[exponent], digits,
+                    rect.x + (rect.w - textW) / 2,
+                    rect.y + (rect.h - 7 * px) / 2, px);
+    }
+  }
+
+  setColor(r, Palette::backgroundPink());
+  clear(r);
+  setColor(r, SDL_Color{255, 255, 255, 35});
+  fillRects(r, m_wallBases);
+  setColor(r, Palette::gridEmptyCellColor());
+  fillRects(r, m_wallCells);
+  for (int e = 1; e <= Palette::kMaxTileExponent; ++e)
+  {
+    if (m_wallTiles[e].empty())
+      continue;
+    setColor(r, Palette::tileColorByExponent(e));
+    fillRects(r, m_wallTiles[e]);
+  }
+
+  // Text: exponents sharing a color go out as one fill.
+  std::vector<SDL_Rect> &text = m_overlayRects;
+  for (int e = 1; e <= Palette::kMaxTileExponent;)
+  {
+    const SDL_Color color = Palette::tileTextColorByExponent(e);
+    text.clear();
+    for (; e <= Palette::kMaxTileExponent; ++e)
+    {
+      const SDL_Color c = Palette::tileTextColorByExponent(e);
+      if (c.r != color.r || c.g != color.g || c.b != color.b ||
+          c.a != color.a)
+        break;
+      text.insert(text.end(), m_wallText[e].begin(), m_wallText[e].end());
+    }
+    if (text.empty())
+      continue;
+    setColor(r, color);
+    fillRects(r, text);
+  }
+
+  m_stats.drawCalls = g_drawCalls - drawCallsBefore;
+}
+
+void Renderer::renderPerfOverlay(SDL_Renderer *r, const FrameStats &stats,
+                                 const InputLatency *latency)
+{
+  TT_TRACE_SCOPE("Renderer::perfOverlay");
+  const int drawCallsBefore = g_drawCalls;
+
+  const int cell = 2;
+  const int lineH = 7 * cell + 4;
+  const int pad = 6;
+  const int barW = 2;
+  const int graphH = 60;
+  const float graphMaxMs = 50.0f;
+  const int lines = 6;
+  const SDL_Rect panel{8, 8, FrameStats::kHistory * barW + 2 * pad,
+                       2 * pad + lines * lineH + graphH};
+  setColor(r, SDL_Color{0, 0, 0, 170});
+  fillRect(r, &panel);
+
+  // Window averages: per-frame values flicker too much to read.
+  const FrameSample avg = stats.average();
+  char text[6][32];
+  std::snprintf(text[0], sizeof(text[0]), "FPS %.1f MAX %.1f", stats.fps(),
+                stats.maxFrameMs());
+  std::snprintf(text[1], sizeof(text[1]), "UPDATE %.2f", avg.updateMs);
+  std::snprintf(text[2], sizeof(text[2]), "RENDER %.2f", avg.renderMs);
+  std::snprintf(text[3], sizeof(text[3]), "PRESENT %.2f", avg.presentMs);
+  std::snprintf(text[4], sizeof(text[4]), "DRAWS %d ALLOCS %d",
+                avg.drawCalls, avg.allocations);
+  if (latency && latency->count() > 0)
+    std::snprintf(text[5], sizeof(text[5]), "INPUT P50 %.1f P99 %.1f",
+                  latency->percentileMs(0.5), latency->percentileMs(0.99));
+  else
+    std::snprintf(text[5], sizeof(text[5]), "INPUT --");
+
+  std::vector<SDL_Rect> &batch = m_overlayRects;
+  batch.clear();
+  for (int i = 0; i < lines; ++i)
+    appendText5x7(batch, text[i], panel.x + pad, panel.y + pad + i * lineH,
+                  cell);
+  setColor(r, SDL_Color{255, 255, 255, 235});
+  fillRects(r, batch);
+
+  // Frame-time graph, newest frame on the right, one batch per color:
+  // on time for 60 Hz, missed one vblank, missed more.
+  const int graphBottom = panel.y + panel.h - pad;
+  const int graphX =
+      panel.x + pad + (FrameStats::kHistory - stats.count()) * barW;
+  auto barHeight = [&](float ms)
+  {
+    const float f = std::min(1.0f, std::max(0.0f, ms / graphMaxMs));
+    return std::max(1, static_cast<int>(f * graphH));
+  };
+  const float bands[3][2] = {{0.0f, 17.5f}, {17.5f, 34.0f}, {34.0f, 1e9f}};
+  const SDL_Color bandColors[3] = {
+      {90, 220, 120, 255}, {240, 200, 70, 255}, {240, 80, 80, 255}};
+  for (int band = 0; band < 3; ++band)
+  {
+    batch.clear();
+    for (int i = 0; i < stats.count(); ++i)
+    {
+      const float ms = stats.at(i).frameMs;
+      if (ms < bands[band][0] || ms >= bands[band][1])
+        continue;
+      const int h = barHeight(ms);
+      batch.push_back(
+          SDL_Rect{graphX + i * barW, graphBottom - h, barW - 1, h});
+    }
+    setColor(r, bandColors[band]);
+    fillRects(r, batch);
+  }
+
+  // 60 Hz and 30 Hz budget lines.
+  batch.clear();
+  for (const float ms : {1000.0f / 60.0f, 1000.0f / 30.0f})
+    batch.push_back(SDL_Rect{panel.x + pad, graphBottom - barHeight(ms),
+                             FrameStats::kHistory * barW, 1});
+  setColor(r, SDL_Color{255, 255, 255, 110});
+  fillRects(r, batch);
+
+  m_stats.drawCalls += g_drawCalls - drawCallsBefore;
 }
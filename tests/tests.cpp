@@ -1,13 +1,49 @@
+#include <tiletwister/game/Bitboard.hpp>
+#include <tiletwister/game/Expectimax.hpp>
 #include <tiletwister/game/Game.hpp>
+#include <tiletwister/game/GameHistory.hpp>
+#include <tiletwister/game/GameWall.hpp>
+#include <tiletwister/game/HintService.hpp>
+#include <tiletwister/game/MovePolicy.hpp>
+#include <tiletwister/game/RenderSnapshot.hpp>
+#include <tiletwister/game/SaveFile.hpp>
+#include <tiletwister/game/SessionPool.hpp>
+#include <tiletwister/game/SessionProtocol.hpp>
+#include <tiletwister/game/TileStore.hpp>
+#include <tiletwister/core/AllocHooks.hpp>
+#include <tiletwister/core/AsyncFileWriter.hpp>
+#include <tiletwister/core/FixedTimestep.hpp>
+#include <tiletwister/core/FrameStats.hpp>
+#include <tiletwister/core/InputLatency.hpp>
+#include <tiletwister/core/Metrics.hpp>
+#include <tiletwister/core/MetricsExporter.hpp>
+#include <tiletwister/core/SpscQueue.hpp>
+#include <tiletwister/core/Trace.hpp>
+#include <tiletwister/core/TripleBuffer.hpp>
+#include <tiletwister/core/Tween.hpp>
 #include <tiletwister/core/Utils.hpp>
 #include <tiletwister/engine/Scene.hpp>
 
+#include <algorithm>
 #include <cassert>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
 #include <cstring>
+#include <fstream>
 #include <iostream>
+#include <sstream>
 #include <string>
+#include <thread>
 #include <vector>
 
+#ifndef _WIN32
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
 static void expectGridEq(const Game& g, const int expected[4][4]) {
   for (int r = 0; r < 4; ++r) {
     for (int c = 0; c < 4; ++c) {
@@ -151,6 +187,1101 @@ static void testSpawnPendingAndCommit() {
   assert(g.grid()[c.r][c.c] == v);
 }
 
+// Verifies buffered-input support in Game: a move issued while the previous
+// move's spawn is still pending is accepted, and the pending spawn is
+// committed first (so it is part of the board the new move slides).
+static void testMoveWhileSpawnPendingCommitsSpawn() {
+  Game g;
+  const int in[4][4] = {
+      {2, 2, 0, 0},
+      {0, 0, 0, 0},
+      {0, 0, 0, 0},
+      {0, 0, 0, 0},
+  };
+  g.setGridForTest(in);
+  const MoveResult first = g.tryMove(Direction::Left);
+  assert(first.moved && first.pendingSpawn.has_value());
+
+  int total = 0;
+  const MoveResult second = g.tryMove(Direction::Right);
+  assert(second.moved);
+  for (int r = 0; r < 4; ++r)
+    for (int c = 0; c < 4; ++c) total += g.grid()[r][c];
+  // 4 from the merge + the first spawn (the second spawn is still pending).
+  assert(total == 4 + first.pendingSpawn->second);
+}
+
+// Verifies allocation-free integer formatting used by the renderer:
+// - matches std::to_string for zero, positive, negative and extreme values
+// - refuses (returns 0, empty string) when the buffer is too small.
+static void testFormatIntMatchesToString() {
+  const int values[] = {0, 7, 10, 2048, 131072, -5, 2147483647, -2147483647 - 1};
+  for (int v : values) {
+    char buf[12];
+    const int n = Utils::formatInt(v, buf, sizeof(buf));
+    assert(n == static_cast<int>(std::to_string(v).size()));
+    assert(std::string(buf) == std::to_string(v));
+  }
+
+  char small[4];
+  assert(Utils::formatInt(1234, small, sizeof(small)) == 0);
+  assert(small[0] == '\0');
+  assert(Utils::formatInt(123, small, sizeof(small)) == 3);
+}
+
+// Verifies the tile exponent helper that indexes the palette tables:
+// exact log2 for powers of two (past 2048), 0 for empty cells.
+static void testTileExponent() {
+  assert(Utils::tileExponent(0) == 0);
+  assert(Utils::tileExponent(2) == 1);
+  assert(Utils::tileExponent(2048) == 11);
+  assert(Utils::tileExponent(131072) == 17);
+  for (int e = 1; e <= 17; ++e) assert(Utils::tileExponent(1 << e) == e);
+}
+
+// Verifies the fixed-step clock and render interpolation:
+// - uneven frame times turn into whole steps plus a fractional alpha
+// - a stall runs at most maxStepsPerFrame steps and drops the rest
+// - TweenPool::sample blends between the previous and the latest update.
+static void testFixedTimestepAndInterpolation() {
+  FixedTimestep clock(0.01, 4);
+  int steps = clock.advance(0.004);
+  assert(steps == 0);
+  assert(std::fabs(clock.alpha() - 0.4f) < 1e-4f);
+  steps = clock.advance(0.021);
+  assert(steps == 2);
+  assert(std::fabs(clock.alpha() - 0.5f) < 1e-4f);
+  steps = clock.advance(1.0); // stall
+  assert(steps == 4);
+  assert(std::fabs(clock.droppedSec() - 0.96) < 1e-6);
+  assert(std::fabs(clock.alpha() - 0.5f) < 1e-4f);
+  steps = clock.advance(-1.0);
+  assert(steps == 0);
+
+  int total = 0;
+  FixedTimestep steady(1.0 / 120.0);
+  for (int i = 0; i < 144; ++i) total += steady.advance(1.0 / 144.0);
+  assert(total >= 119 && total <= 120);
+
+  TweenPool pool;
+  const TweenHandle h = pool.start(0.0f, 0.0f, 10.0f, 20.0f, 1.0f,
+                                   Easing::Linear);
+  float a = 0.0f, b = 0.0f;
+  bool sampled = pool.sample(h, 0.5f, a, b);
+  assert(sampled && a == 0.0f && b == 0.0f);
+  pool.update(0.5f);
+  sampled = pool.sample(h, 0.5f, a, b);
+  assert(sampled);
+  assert(std::fabs(a - 2.5f) < 1e-4f && std::fabs(b - 5.0f) < 1e-4f);
+  pool.update(0.25f);
+  sampled = pool.sample(h, 0.0f, a, b);
+  assert(sampled && std::fabs(a - 5.0f) < 1e-4f);
+  sampled = pool.sample(h, 1.0f, a, b);
+  assert(sampled && std::fabs(a - 7.5f) < 1e-4f);
+}
+
+// Verifies the SoA tween pool:
+// - values follow the easing curve after a batched update
+// - finished tweens retire (handle becomes inactive) while others keep going
+// - a recycled slot does not revive a stale handle.
+static void testTweenPoolBatchedUpdate() {
+  TweenPool pool(4);
+  const TweenHandle slide = pool.start(0.0f, 3.0f, 3.0f, 0.0f, 1.0f, Easing::OutCubic);
+  const TweenHandle pop = pool.start(1.0f, 0.0f, 1.12f, 0.0f, 0.5f, Easing::Pulse);
+  assert(pool.size() == 2);
+
+  pool.update(0.25f);
+  float a = 0.0f, b = 0.0f;
+  assert(pool.value(slide, a, b));
+  const float k = Utils::easeOutCubic(0.25f);
+  assert(std::fabs(a - 3.0f * k) < 1e-5f);
+  assert(std::fabs(b - (3.0f - 3.0f * k)) < 1e-5f);
+  assert(pool.value(pop, a, b));
+  assert(std::fabs(a - 1.12f) < 1e-5f); // pulse peaks at t=0.5
+
+  pool.update(0.25f);
+  assert(!pool.active(pop)); // done after 0.5s
+  assert(pool.active(slide));
+  assert(pool.size() == 1);
+
+  const TweenHandle reused = pool.start(0.0f, 0.0f, 1.0f, 1.0f, 1.0f, Easing::Linear);
+  assert(reused.slot == pop.slot);
+  assert(!pool.active(pop));
+  assert(pool.active(reused));
+
+  pool.update(1.0f);
+  assert(pool.size() == 0);
+  assert(!pool.value(slide, a, b));
+}
+
+// Verifies the persistent tile store across one animated move:
+// - tiles keep their ids while sliding (no rebuild)
+// - the merge source is retired and the survivor takes the merged value + pops
+// - the committed spawn gets a new popping tile, and the store matches the grid.
+static void testTileStoreMoveKeepsIdsAndMerges() {
+  Game g;
+  const int in[4][4] = {
+      {2, 2, 0, 4},
+      {0, 0, 0, 0},
+      {0, 0, 0, 0},
+      {0, 0, 0, 0},
+  };
+  g.setGridForTest(in);
+  TileStore store;
+  store.syncFromGrid(g.grid());
+  assert(store.size() == 3);
+  const int idA = store.tileAt(Cell{0, 0});
+  const int idB = store.tileAt(Cell{0, 1});
+  const int idFour = store.tileAt(Cell{0, 3});
+  assert(idA != TileStore::kNone && idB != TileStore::kNone);
+
+  const MoveResult mr = g.tryMove(Direction::Left);
+  assert(mr.moved);
+  store.beginMove(mr, 0.1f);
+  assert(store.movePending());
+  // Both sources slide into (0,0); the 4 slides to (0,1) with the same id.
+  assert(store.size() == 3);
+  assert(store.tileAt(Cell{0, 1}) == idFour);
+  assert(store.isSliding(idFour));
+  const int survivor = store.tileAt(Cell{0, 0});
+  assert(survivor == idA || survivor == idB);
+
+  store.update(1.0f);
+  assert(!store.isSliding(idFour));
+
+  g.commitPendingSpawn();
+  store.finishMove(g.grid());
+  assert(!store.movePending());
+  assert(store.matchesGrid(g.grid()));
+  assert(store.tileAt(Cell{0, 0}) == survivor);
+  assert(store.tile(survivor).value() == 4);
+  assert(store.isPopping(survivor));
+  assert(store.tileAt(Cell{0, 1}) == idFour);
+  assert(store.size() == 3); // 4, 4, spawned tile
+  const Cell sc = mr.pendingSpawn->first;
+  assert(store.tileAt(sc) != TileStore::kNone);
+  assert(store.isPopping(store.tileAt(sc)));
+}
+
+// Verifies fast-forwarding a move (input queued mid-slide): finishMove before
+// the slide completes snaps tiles to their cells, and the next move can start
+// right away with the store still matching the board.
+static void testTileStoreFastForward() {
+  Game g;
+  const int in[4][4] = {
+      {2, 0, 0, 2},
+      {0, 4, 0, 0},
+      {0, 0, 0, 0},
+      {0, 0, 8, 0},
+  };
+  g.setGridForTest(in);
+  TileStore store;
+  store.syncFromGrid(g.grid());
+
+  const Direction dirs[] = {Direction::Left, Direction::Down, Direction::Right,
+                            Direction::Up};
+  for (Direction d : dirs) {
+    const MoveResult mr = g.tryMove(d);
+    if (!mr.moved) continue;
+    store.beginMove(mr, 0.12f);
+    store.update(0.01f); // mid-slide
+    g.commitPendingSpawn();
+    store.finishMove(g.grid());
+    for (int i = 0; i < store.size(); ++i) assert(!store.isSliding(store.idAt(i)));
+    assert(store.matchesGrid(g.grid()));
+  }
+}
+
+static std::string readFile(const std::string& path) {
+  std::ifstream in(path, std::ios::binary);
+  std::ostringstream ss;
+  ss << in.rdbuf();
+  return ss.str();
+}
+
+// Verifies background persistence:
+// - a burst of submits for one path coalesces (latest contents win)
+// - flush() returns only after the data is on disk (atomic rename, no .tmp).
+static void testAsyncFileWriterCoalescesAndFlushes() {
+  const std::string path = "tiletwister_test_async.txt";
+  {
+    AsyncFileWriter writer(20);
+    for (int i = 0; i <= 100; ++i)
+      writer.submit(path, "best=" + std::to_string(i) + "\n");
+    writer.flush();
+    assert(readFile(path) == "best=100\n");
+    assert(writer.writesCompleted() >= 1 && writer.writesCompleted() < 101);
+    assert(writer.writesFailed() == 0);
+    assert(!std::ifstream(path + ".tmp").good());
+
+    // Destructor flushes whatever is still queued.
+    writer.submit(path, "best=7\n");
+  }
+  assert(readFile(path) == "best=7\n");
+  std::remove(path.c_str());
+}
+
+// Verifies save/resume:
+// - a GameState survives encode/decode and a file round trip unchanged
+// - the restored game continues with the exact same spawns (rng state saved)
+// - the play time is saved; version 1 records still load
+// - corrupted records and pending spawns onto a tile are rejected.
+static void testSaveFileRoundTripAndResume() {
+  Game a(42);
+  const Direction dirs[] = {Direction::Left, Direction::Up, Direction::Right,
+                            Direction::Down};
+  for (int i = 0; i < 12; ++i) {
+    a.tryMove(dirs[i % 4]);
+    if (i % 3 != 0) a.commitPendingSpawn(); // sometimes leave a spawn pending
+  }
+
+  const std::string path = "tiletwister_test_save.bin";
+  const bool written = writeFileAtomic(path, saveBytes(a.state()));
+  assert(written);
+  GameState loaded;
+  const bool read = loadSaveFile(path, loaded);
+  assert(read);
+  std::remove(path.c_str());
+
+  Game b(7);
+  b.restore(loaded);
+  assert(b.score() == a.score());
+  assert(b.moveCount() == a.moveCount());
+  assert(b.seed() == a.seed());
+  for (int i = 0; i < 20; ++i) {
+    const MoveResult ma = a.tryMove(dirs[i % 4]);
+    const MoveResult mb = b.tryMove(dirs[i % 4]);
+    assert(ma.moved == mb.moved);
+    int grid[4][4];
+    std::memcpy(grid, a.grid(), sizeof(grid));
+    expectGridEq(b, grid);
+  }
+
+  GameState played = a.state();
+  played.playedMs = 123456;
+  SaveRecord rec = encodeSave(played);
+  GameState out;
+  const bool decoded = decodeSave(rec, out);
+  assert(decoded && out.playedMs == 123456);
+  rec.playedMs += 1; // covered by the checksum
+  const bool badTime = decodeSave(rec, out);
+  assert(!badTime);
+  rec.playedMs -= 1;
+  rec.score += 1;
+  const bool badScore = decodeSave(rec, out);
+  assert(!badScore);
+
+  // Version 1 saves (no play time) still load.
+  SaveRecord v1 = encodeSave(a.state());
+  v1.version = 1;
+  std::uint32_t h = 2166136261u;
+  const auto* bytes = reinterpret_cast<const unsigned char*>(&v1);
+  for (std::size_t i = 0; i < offsetof(SaveRecord, checksum); ++i) {
+    h ^= bytes[i];
+    h *= 16777619u;
+  }
+  v1.checksum = h;
+  const bool decodedV1 = decodeSave(v1, out);
+  assert(decodedV1 && out.playedMs == 0 && out.score == a.score());
+
+  // A pending spawn onto an occupied cell is rejected, even when checksummed.
+  GameState bad = a.state();
+  bad.grid[1][2] = 8;
+  bad.pendingSpawn = std::make_pair(Cell{1, 2}, 2);
+  const bool occupied = decodeSave(encodeSave(bad), out);
+  assert(!occupied);
+  bad.grid[1][2] = 0;
+  const bool empty = decodeSave(encodeSave(bad), out);
+  assert(empty);
+}
+
+// Verifies the append-only game history:
+// - records appended across two writer sessions (restart) are all readable
+// - block index entries are written and used; queries agree with a plain scan
+// - a deleted index is rebuilt by the next writer and ignored by readers, as
+//   is one that can't belong to the log; a mismatched one is never read past
+// - score buckets are monotonic and cover every int32 score.
+static void testGameHistoryAppendAndQueries() {
+  int prev = historyScoreBucket(-5);
+  assert(prev == 0 && historyScoreBucket(15) == 15);
+  for (std::int64_t score = 1; score <= 2147483647; score = score * 9 / 8 + 1) {
+    const int b = historyScoreBucket(static_cast<std::int32_t>(score));
+    assert(b >= prev && b < kHistoryScoreBuckets);
+    prev = b;
+  }
+  assert(historyScoreBucket(2147483647) == kHistoryScoreBuckets - 1);
+
+  const std::string path = "tiletwister_test_history.bin";
+  std::remove(path.c_str());
+  std::remove((path + ".idx").c_str());
+
+  const int total = static_cast<int>(kHistoryBlockRecords) * 2 + 100;
+  auto makeRecord = [](int i) {
+    GameRecord rec{};
+    rec.finishedAtMs = 1000 + i;
+    rec.seed = static_cast<std::uint64_t>(i);
+    rec.score = (i * 7919) % 50000;
+    rec.maxTile = 1 << (1 + i % 12);
+    rec.moveCount = static_cast<std::uint32_t>(i);
+    rec.durationMs = 10;
+    return rec;
+  };
+
+  {
+    AsyncFileWriter io(0);
+    GameHistoryWriter w(path, io);
+    w.open();
+    for (int i = 0; i < 5000; ++i) w.append(makeRecord(i));
+  }
+  {
+    AsyncFileWriter io(0);
+    GameHistoryWriter w(path, io); // second session continues the block
+    w.open();
+    assert(w.size() == 5000);
+    for (int i = 5000; i < total; ++i) w.append(makeRecord(i));
+  }
+
+  std::vector<int> scores;
+  for (int i = 0; i < total; ++i) scores.push_back(makeRecord(i).score);
+  std::sort(scores.begin(), scores.end());
+  auto checkPercentiles = [&](const GameHistory& h) {
+    assert(h.scorePercentile(0) == scores.front());
+    assert(h.scorePercentile(100) == scores.back());
+    for (double p : {0.1, 1.0, 25.0, 50.0, 90.0, 99.0, 99.9}) {
+      const auto k = static_cast<std::size_t>(
+          std::llround(p / 100.0 * static_cast<double>(scores.size() - 1)));
+      assert(h.scorePercentile(p) == scores[k]);
+    }
+  };
+
+  auto check = [&]() {
+    GameHistory h;
+    const bool opened = h.open(path);
+    assert(opened);
+    assert(h.size() == static_cast<std::uint64_t>(total));
+    assert(h.record(1234).score == makeRecord(1234).score);
+
+    for (std::uint64_t n : {1ull, 1000ull, 5000ull, 100000ull}) {
+      int best = 0;
+      const std::uint64_t begin = n >= h.size() ? 0 : h.size() - n;
+      for (std::uint64_t i = begin; i < h.size(); ++i)
+        best = std::max(best, makeRecord(static_cast<int>(i)).score);
+      assert(h.bestOfLast(n) == best);
+    }
+
+    const auto hist = h.maxTileHistogram();
+    std::uint64_t sum = 0;
+    for (std::uint64_t c : hist) sum += c;
+    assert(sum == h.size());
+    assert(hist[0] == 0 && hist[1] > 0);
+    checkPercentiles(h);
+  };
+  check();
+  assert(std::ifstream(path + ".idx").good());
+
+  std::remove((path + ".idx").c_str());
+  check(); // readers fall back to scanning
+  {
+    AsyncFileWriter io(0);
+    GameHistoryWriter w(path, io);
+    w.open(); // rebuilds the index
+  }
+  assert(std::ifstream(path + ".idx").good());
+  check();
+
+  // An index whose block counts don't add up is ignored.
+  std::string index = readFile(path + ".idx");
+  HistoryBlockSummary first;
+  std::memcpy(&first, index.data() + sizeof(HistoryFileHeader), sizeof(first));
+  first.count -= 1;
+  std::memcpy(&index[sizeof(HistoryFileHeader)], &first, sizeof(first));
+  const bool corrupted = writeFileAtomic(path + ".idx", index);
+  assert(corrupted);
+  check();
+
+  // Indexes of another log: one covering more blocks than this log has is
+  // ignored; one of the same length can't be told apart, but queries still
+  // answer with scores of this log.
+  const std::string other = "tiletwister_test_history_other.bin";
+  auto writeOther = [&](int count) {
+    std::remove(other.c_str());
+    std::remove((other + ".idx").c_str());
+    AsyncFileWriter io(0);
+    GameHistoryWriter w(other, io);
+    w.open();
+    GameRecord rec{};
+    rec.score = 5;
+    rec.maxTile = 2;
+    for (int i = 0; i < count; ++i) w.append(rec);
+  };
+  writeOther(total + static_cast<int>(kHistoryBlockRecords));
+  const bool longer = writeFileAtomic(path + ".idx", readFile(other + ".idx"));
+  assert(longer);
+  check();
+  writeOther(total);
+  const bool sameLength =
+      writeFileAtomic(path + ".idx", readFile(other + ".idx"));
+  assert(sameLength);
+  {
+    GameHistory h;
+    const bool opened = h.open(path);
+    assert(opened);
+    for (double p : {0.0, 50.0, 99.0, 100.0}) {
+      const int score = h.scorePercentile(p);
+      assert(std::binary_search(scores.begin(), scores.end(), score));
+    }
+  }
+
+  std::remove(path.c_str());
+  std::remove((path + ".idx").c_str());
+  std::remove(other.c_str());
+  std::remove((other + ".idx").c_str());
+}
+
+// Verifies the update/render thread hand-off:
+// - TripleBuffer readers only ever see complete, increasingly newer values
+// - SpscQueue delivers every item once, in order, across threads
+// - captureTiles emits tiles in draw order with previous/latest positions.
+static void testSnapshotHandOff() {
+  struct Frame {
+    std::uint64_t seq;
+    std::uint64_t payload[32];
+  };
+  TripleBuffer<Frame> buffer;
+  SpscQueue<int, 64> queue;
+  const std::uint64_t kFrames = 200000;
+  const int kItems = 100000;
+
+  std::thread writer([&] {
+    for (std::uint64_t i = 1; i <= kFrames; ++i) {
+      Frame& f = buffer.writeBuffer();
+      f.seq = i;
+      for (std::uint64_t& p : f.payload) p = i * 3;
+      buffer.publish();
+    }
+    for (int i = 0; i < kItems; ++i)
+      while (!queue.push(i)) std::this_thread::yield();
+  });
+
+  std::uint64_t lastSeq = 0;
+  while (lastSeq < kFrames) {
+    if (!buffer.acquire()) continue;
+    const Frame& f = buffer.read();
+    assert(f.seq > lastSeq);
+    for (std::uint64_t p : f.payload) assert(p == f.seq * 3);
+    lastSeq = f.seq;
+  }
+  const bool stale = buffer.acquire();
+  assert(!stale);
+
+  int expected = 0;
+  while (expected < kItems) {
+    int v = -1;
+    if (!queue.pop(v)) continue;
+    assert(v == expected);
+    ++expected;
+  }
+  writer.join();
+  int extra = 0;
+  const bool leftover = queue.pop(extra);
+  assert(!leftover);
+
+  TileStore tiles;
+  const int grid[4][4] = {
+      {8, 0, 0, 2}, {0, 0, 0, 0}, {0, 0, 4, 0}, {0, 0, 0, 0}};
+  tiles.syncFromGrid(grid);
+  const int id = tiles.tileAt(Cell{0, 3});
+  tiles.startSlide(id, Cell{0, 3}, Cell{0, 1}, 1.0f);
+  tiles.update(0.5f);
+  RenderSnapshot frame;
+  captureTiles(tiles, frame);
+  assert(frame.tileCount == 3);
+  assert(frame.tiles[0].value == 2 && frame.tiles[1].value == 4 &&
+         frame.tiles[2].value == 8);
+  assert(frame.tiles[0].col0 == 3.0f);
+  assert(frame.tiles[0].col1 < 3.0f && frame.tiles[0].col1 > 1.0f);
+  assert(frame.tiles[2].col0 == 0.0f && frame.tiles[2].col1 == 0.0f);
+}
+
+// Verifies the packed search board against the game rules:
+// - fromGrid/toGrid round-trip
+// - Bitboards::move matches Game::tryMove (grid and score) on random boards
+// - an unchanged board means the move is illegal.
+static void testBitboardMatchesGame() {
+  Rng rng(2048);
+  const Direction dirs[] = {Direction::Left, Direction::Right, Direction::Up,
+                            Direction::Down};
+  for (int iter = 0; iter < 2000; ++iter) {
+    int grid[4][4];
+    for (int r = 0; r < 4; ++r)
+      for (int c = 0; c < 4; ++c) {
+        const int e = rng.below(6); // mostly small values: many merges
+        grid[r][c] = e == 0 ? 0 : 1 << e;
+      }
+    const Bitboard b = Bitboards::fromGrid(grid);
+    int back[4][4];
+    Bitboards::toGrid(b, back);
+    assert(std::memcmp(back, grid, sizeof grid) == 0);
+
+    for (Direction d : dirs) {
+      Game g;
+      g.setGridForTest(grid);
+      g.clearPendingSpawnForTest();
+      const int scoreBefore = g.score();
+      const MoveResult res = g.tryMove(d);
+
+      int gained = 0;
+      const Bitboard moved = Bitboards::move(b, d, &gained);
+      assert(res.moved == (moved != b));
+      Bitboards::toGrid(moved, back);
+      expectGridEq(g, back);
+      assert(gained == g.score() - scoreBefore);
+    }
+  }
+}
+
+// Verifies the expectimax search:
+// - finds a legal move and reports the depth it reached
+// - returns within its deadline with the last completed depth
+// - a set cancel flag aborts it; a board without moves has no answer.
+static void testExpectimaxSearch() {
+  const int grid[4][4] = {
+      {2, 4, 8, 16},
+      {0, 2, 0, 4},
+      {0, 0, 2, 0},
+      {0, 0, 0, 2},
+  };
+  const Bitboard b = Bitboards::fromGrid(grid);
+
+  SearchLimits shallow;
+  shallow.maxDepth = 2;
+  SearchResult res = searchBestMove(b, shallow);
+  assert(res.found && !res.cancelled && res.depth == 2 && res.nodes > 0);
+  assert(Bitboards::move(b, res.dir) != b);
+
+  SearchLimits timed;
+  timed.maxDepth = 64;
+  const auto start = std::chrono::steady_clock::now();
+  timed.deadline = start + std::chrono::milliseconds(30);
+  res = searchBestMove(b, timed);
+  const auto took = std::chrono::steady_clock::now() - start;
+  assert(res.found && res.depth >= 1 && res.depth < 64);
+  assert(took < std::chrono::milliseconds(500));
+
+  std::atomic<bool> cancel{true};
+  SearchLimits cancelled;
+  cancelled.cancel = &cancel;
+  res = searchBestMove(b, cancelled);
+  assert(res.cancelled && !res.found);
+
+  const int stuck[4][4] = {
+      {2, 4, 2, 4},
+      {4, 2, 4, 2},
+      {2, 4, 2, 4},
+      {4, 2, 4, 2},
+  };
+  res = searchBestMove(Bitboards::fromGrid(stuck), shallow);
+  assert(!res.found);
+}
+
+// Verifies the background hint service:
+// - a request's result arrives through poll() with the request's id
+// - a newer request replaces it; cancel() drops it
+// - a board without legal moves never produces a hint.
+static void testHintService() {
+  HintService hints(50, 4);
+  HintService::Hint hint;
+  const bool early = hints.poll(hint);
+  assert(!early);
+
+  const int grid[4][4] = {
+      {2, 2, 0, 0},
+      {0, 0, 0, 0},
+      {0, 0, 4, 0},
+      {0, 0, 0, 0},
+  };
+  auto waitFor = [&](HintService::Hint& out) {
+    for (int i = 0; i < 60; ++i) {
+      if (hints.poll(out)) return true;
+      std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    return false;
+  };
+
+  const std::uint32_t first = hints.request(grid);
+  const std::uint32_t second = hints.request(grid);
+  assert(second != first);
+  const bool arrived = waitFor(hint);
+  assert(arrived);
+  assert(hint.request == second && hint.depth >= 1);
+  const Bitboard b = Bitboards::fromGrid(grid);
+  assert(Bitboards::move(b, hint.dir) != b);
+
+  hints.request(grid);
+  hints.cancel();
+  const bool late = waitFor(hint);
+  assert(!late);
+
+  const int stuck[4][4] = {
+      {2, 4, 2, 4},
+      {4, 2, 4, 2},
+      {2, 4, 2, 4},
+      {4, 2, 4, 2},
+  };
+  hints.request(stuck);
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  const bool hinted = hints.poll(hint);
+  assert(!hinted);
+}
+
+// Verifies the autoplay policies:
+// - every policy only picks legal moves and plays a game to the end
+// - expectimax plays clearly better than chance
+// - choosing a move doesn't allocate once the policy exists
+// - makeMovePolicy knows the built-in names only.
+static void testMovePolicies() {
+  for (const char* name : {"random", "corner", "expectimax"}) {
+    auto policy = makeMovePolicy(name, 7);
+    assert(policy);
+    Game game(2024);
+    game.commitPendingSpawn();
+    int maxTile = 0;
+    const AllocScope scope;
+    while (!game.isGameOver()) {
+      Direction dir;
+      const bool chosen = policy->chooseMove(game.grid(), dir);
+      assert(chosen);
+      const bool moved = game.tryMove(dir).moved;
+      assert(moved);
+      game.commitPendingSpawn();
+    }
+    assert(scope.allocations() == 0);
+    for (const auto& row : game.grid())
+      for (int v : row) maxTile = std::max(maxTile, v);
+    if (std::strcmp(name, "expectimax") == 0) assert(maxTile >= 512);
+
+    Direction dir;
+    const bool chosen = policy->chooseMove(game.grid(), dir);
+    assert(!chosen);
+  }
+  assert(!makeMovePolicy("minimax", 0));
+}
+
+// Verifies the wall of independent games:
+// - workers split the boards between them and each steps only its slice
+// - every board plays at the configured speed and publishes its board
+// - finished games restart after kRestartSec; threads start and stop cleanly.
+static void testGameWall() {
+  GameWall wall(10, 3, "random", 120, 5);
+  assert(wall.boardCount() == 10 && wall.workerCount() == 3);
+  WallSnapshot before;
+  wall.snapshot(before);
+  assert(before.boardCount == 10);
+  for (int i = 0; i < 10; ++i) assert(before.boards[i] != 0);
+
+  // One worker's step moves only its slice: a tenth of a second at 120
+  // moves/sec is 12 moves per board.
+  wall.stepWorker(0, 0.1f);
+  WallSnapshot after;
+  wall.snapshot(after);
+  int changed = 0;
+  for (int i = 0; i < 10; ++i) changed += after.boards[i] != before.boards[i];
+  assert(changed > 0 && changed < 10);
+  assert(wall.moves() > 0 && wall.moves() <= 12u * 4);
+
+  // A finished game stays up for kRestartSec, then starts over.
+  GameWall single(1, 1, "corner", 120, 9);
+  while (single.gamesFinished() == 0) single.stepWorker(0, 0.5f);
+  WallSnapshot one;
+  single.snapshot(one);
+  for (const Direction d : {Direction::Left, Direction::Right, Direction::Up,
+                            Direction::Down})
+    assert(Bitboards::move(one.boards[0], d) == one.boards[0]);
+  single.stepWorker(0, GameWall::kRestartSec / 2);
+  WallSnapshot still;
+  single.snapshot(still);
+  assert(still.boards[0] == one.boards[0]);
+  single.stepWorker(0, GameWall::kRestartSec / 2);
+  single.snapshot(one);
+  assert(Bitboards::countEmpty(one.boards[0]) == 14); // fresh board
+
+  const std::uint64_t moves = wall.moves();
+  wall.start();
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  wall.stop();
+  assert(wall.moves() > moves);
+}
+
+// Verifies the session pool:
+// - a session plays exactly like Game(seed): grid, score, moves, game over
+// - a full pool refuses new games; destroyed ids go stale, even after their
+//   slot is reused.
+static void testSessionPool() {
+  SessionPool pool(4);
+  assert(pool.capacity() == 4 && pool.live() == 0);
+  const Direction dirs[] = {Direction::Left, Direction::Right, Direction::Up,
+                            Direction::Down};
+  for (std::uint64_t seed = 1; seed <= 3; ++seed) {
+    Game g(seed);
+    const std::uint32_t id = pool.create(seed, 7);
+    Session* s = pool.find(id);
+    assert(s && s->owner == 7);
+    Rng rng(seed * 31);
+    int grid[4][4];
+    while (!g.isGameOver()) {
+      Bitboards::toGrid(s->board, grid);
+      expectGridEq(g, grid);
+      const Direction d = dirs[rng.below(4)];
+      const bool moved = g.tryMove(d).moved;
+      if (moved) g.commitPendingSpawn();
+      const bool played = SessionPool::move(*s, d);
+      assert(played == moved);
+      assert(s->score == static_cast<std::uint32_t>(g.score()));
+      assert(s->moves == g.moveCount());
+    }
+    assert(s->over);
+    Bitboards::toGrid(s->board, grid);
+    expectGridEq(g, grid);
+    const bool destroyed = pool.destroy(id);
+    assert(destroyed);
+  }
+
+  std::uint32_t ids[4];
+  for (std::uint32_t& id : ids) {
+    id = pool.create(0, 1);
+    assert(id != SessionPool::kInvalid);
+  }
+  assert(pool.live() == 4);
+  const std::uint32_t overflow = pool.create(0, 1);
+  assert(overflow == SessionPool::kInvalid);
+  const bool destroyed = pool.destroy(ids[2]);
+  assert(destroyed);
+  const bool destroyedTwice = pool.destroy(ids[2]);
+  assert(!pool.find(ids[2]) && !destroyedTwice);
+  const std::uint32_t reused = pool.create(0, 1);
+  assert(reused != SessionPool::kInvalid && reused != ids[2]);
+  assert(!pool.find(ids[2]) && pool.find(reused));
+  assert(pool.live() == 4);
+}
+
+// Verifies the session wire protocol:
+// - requests and responses survive encode/decode
+// - new game, move, state and close through handleRequest
+// - other connections' sessions are unknown; bad ops are rejected.
+static void testSessionProtocol() {
+  using namespace SessionProtocol;
+  std::uint8_t req[kRequestSize];
+  std::uint8_t resp[kResponseSize];
+
+  Request r;
+  r.op = Op::Move;
+  r.dir = Direction::Down;
+  r.session = 0x01020304;
+  encodeRequest(r, req);
+  Request r2;
+  const bool decoded = decodeRequest(req, r2);
+  assert(decoded);
+  assert(r2.op == Op::Move && r2.dir == Direction::Down &&
+         r2.session == 0x01020304);
+
+  Response a;
+  a.status = Status::PoolFull;
+  a.op = Op::NewGame;
+  a.flags = kFlagMoved | kFlagGameOver;
+  a.session = 42;
+  a.board = 0x123456789abcdef0ull;
+  a.score = 1234;
+  a.moves = 99;
+  encodeResponse(a, resp);
+  Response b;
+  decodeResponse(resp, b);
+  assert(b.status == a.status && b.op == a.op && b.flags == a.flags &&
+         b.session == a.session && b.board == a.board &&
+         b.score == a.score && b.moves == a.moves);
+
+  SessionPool pool(2);
+  r = Request{};
+  r.op = Op::NewGame;
+  r.session = 5; // seed
+  encodeRequest(r, req);
+  const Response created = handleRequest(pool, 1, req, resp);
+  decodeResponse(resp, b);
+  assert(created.status == Status::Ok && b.session == created.session);
+  assert(Bitboards::countEmpty(b.board) == 14 && b.moves == 0);
+
+  // The first legal move, played on Game(5) for reference.
+  Game g(5);
+  Direction legal = Direction::Left;
+  while (!g.tryMove(legal).moved)
+    legal = static_cast<Direction>(static_cast<int>(legal) + 1);
+  g.commitPendingSpawn();
+  r.op = Op::Move;
+  r.dir = legal;
+  r.session = created.session;
+  encodeRequest(r, req);
+  const Response moved = handleRequest(pool, 1, req, resp);
+  assert(moved.status == Status::Ok && (moved.flags & kFlagMoved));
+  assert(moved.moves == 1);
+  assert(moved.score == static_cast<std::uint32_t>(g.score()));
+  int grid[4][4];
+  Bitboards::toGrid(moved.board, grid);
+  expectGridEq(g, grid);
+
+  r.op = Op::State;
+  encodeRequest(r, req);
+  const Response state = handleRequest(pool, 1, req, resp);
+  assert(state.status == Status::Ok && state.board == moved.board &&
+         !(state.flags & kFlagMoved));
+  // Another connection can't see, move or close it.
+  const Response foreign = handleRequest(pool, 2, req, resp);
+  assert(foreign.status == Status::UnknownSession);
+
+  r.op = Op::Close;
+  encodeRequest(r, req);
+  const Response foreignClose = handleRequest(pool, 2, req, resp);
+  assert(foreignClose.status == Status::UnknownSession);
+  const Response closed = handleRequest(pool, 1, req, resp);
+  assert(closed.status == Status::Ok);
+  assert(pool.live() == 0);
+  r.op = Op::State;
+  encodeRequest(r, req);
+  const Response stale = handleRequest(pool, 1, req, resp);
+  assert(stale.status == Status::UnknownSession);
+
+  req[0] = 99;
+  const bool decodedBad = decodeRequest(req, r2);
+  assert(!decodedBad);
+  const Response bad = handleRequest(pool, 1, req, resp);
+  decodeResponse(resp, b);
+  assert(bad.status == Status::BadRequest && b.status == Status::BadRequest);
+}
+
+// Verifies the overlay's rolling frame window:
+// - averages, max and fps cover only the frames pushed so far
+// - after kHistory frames the oldest samples fall out of the window.
+static void testFrameStatsWindow() {
+  FrameStats stats;
+  assert(stats.count() == 0 && stats.fps() == 0.0f);
+
+  for (int i = 0; i < 3; ++i) {
+    FrameSample s;
+    s.frameMs = 10.0f * (i + 1); // 10, 20, 30
+    s.presentMs = 2.0f;
+    s.drawCalls = i;
+    stats.push(s);
+  }
+  assert(stats.count() == 3);
+  assert(stats.at(0).frameMs == 10.0f && stats.at(2).frameMs == 30.0f);
+  assert(std::fabs(stats.average().frameMs - 20.0f) < 1e-4f);
+  assert(std::fabs(stats.average().presentMs - 2.0f) < 1e-4f);
+  assert(stats.average().drawCalls == 1);
+  assert(stats.maxFrameMs() == 30.0f);
+  assert(std::fabs(stats.fps() - 50.0f) < 1e-3f);
+
+  for (int i = 0; i < FrameStats::kHistory; ++i) {
+    FrameSample s;
+    s.frameMs = 16.0f;
+    stats.push(s);
+  }
+  assert(stats.count() == FrameStats::kHistory);
+  assert(stats.maxFrameMs() == 16.0f);
+  assert(std::fabs(stats.fps() - 62.5f) < 1e-3f);
+
+  stats.clear();
+  assert(stats.count() == 0);
+}
+
+// Verifies the hot paths stay allocation-free once warm:
+// - moves (tryMove, spawn commit, game-over check, restarts)
+// - the visual tile store and snapshot capture the simulation runs per step
+// - Scene update/render with a steady set of objects and a system.
+static void testSteadyStateIsAllocationFree() {
+  struct Spinner final : public GameObject {
+    float angle = 0.0f;
+    void update(float dt) override { angle += dt; }
+    void render(SDL_Renderer*) override {}
+  };
+
+  Game game(99);
+  TileStore tiles;
+  tiles.syncFromGrid(game.grid());
+  RenderSnapshot snapshot;
+  FrameStats frames;
+  Scene scene;
+  for (int i = 0; i < 64; ++i) scene.spawn<Spinner>();
+  scene.addSystem(std::make_unique<TweenSystem>());
+  const Entity e = scene.world().create();
+  scene.world().addTransform(e, Transform{});
+  scene.update(0.016f);
+  scene.render(nullptr);
+
+  // The probe itself must count.
+  {
+    AllocScope probe;
+    std::vector<int> v(4);
+    assert(probe.allocations() == 1 && probe.bytes() >= 4 * sizeof(int));
+  }
+
+  const Direction dirs[4] = {Direction::Left, Direction::Up, Direction::Right,
+                             Direction::Down};
+  const AllocScope scope;
+  for (int i = 0; i < 2000; ++i) {
+    const MoveResult mr = game.tryMove(dirs[i % 4]);
+    if (mr.moved) {
+      tiles.beginMove(mr, 0.12f);
+      tiles.update(0.05f);
+      captureTiles(tiles, snapshot);
+      game.commitPendingSpawn();
+      tiles.finishMove(game.grid());
+    }
+    tiles.update(0.05f);
+    captureTiles(tiles, snapshot);
+    if (game.isGameOver()) {
+      game.reset();
+      game.commitPendingSpawn();
+      tiles.syncFromGrid(game.grid());
+    }
+    frames.push(FrameSample{});
+    scene.update(0.016f);
+    scene.render(nullptr);
+  }
+  assert(scope.allocations() == 0);
+}
+
+// Verifies metrics and their export:
+// - histogram buckets round-trip and quantiles land within one bucket
+// - the exporter writes the stats file and reports interval quantiles
+// - (POSIX) a client connecting to the stats socket gets the same text.
+static void testMetricsExport() {
+  for (int b = 0; b < Histogram::kBuckets; ++b)
+    assert(Histogram::bucketOf(Histogram::bucketLow(b)) == b);
+  assert(Histogram::bucketOf(5) == 5 && Histogram::bucketOf(9) == 8);
+
+  Metrics m;
+  for (int i = 1; i <= 100; ++i) m.frameTimeUs.record(16000 + i);
+  m.frameTimeUs.record(100000); // one stutter
+  const Histogram::Snapshot all = m.frameTimeUs.snapshot();
+  assert(all.count == 101);
+  const std::uint64_t p50 = all.quantile(0.5);
+  assert(p50 >= 14000 && p50 <= 18500);
+  assert(all.quantile(1.0) >= 90000);
+  assert(all.since(all).count == 0 && all.since(all).quantile(0.5) == 0);
+
+  m.moves.add(3);
+  m.bestScore.set(2048);
+
+  const std::string path = "tiletwister_test_stats.txt";
+  std::remove(path.c_str());
+  std::string socketPath;
+#ifndef _WIN32
+  socketPath = "tiletwister_test_stats.sock";
+#endif
+  {
+    MetricsExporter exporter(m, path, socketPath, 20);
+    const bool started = exporter.start();
+    assert(started);
+    std::string text;
+    for (int i = 0; i < 200 && text.empty(); ++i) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(5));
+      text = readFile(path);
+    }
+    assert(text.find("tiletwister_moves_total 3\n") != std::string::npos);
+    assert(text.find("tiletwister_best_score 2048\n") != std::string::npos);
+    assert(text.find("tiletwister_frame_time_us_count 101\n") !=
+           std::string::npos);
+    assert(text.find("frame_time_us{quantile=\"0.99\"}") !=
+           std::string::npos);
+
+#ifndef _WIN32
+    const int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    std::strcpy(addr.sun_path, socketPath.c_str());
+    const int rc = ::connect(fd, reinterpret_cast<const sockaddr*>(&addr),
+                             sizeof(addr));
+    assert(rc == 0);
+    std::string reply;
+    char buf[512];
+    for (ssize_t n; (n = ::read(fd, buf, sizeof(buf))) > 0;)
+      reply.append(buf, static_cast<std::size_t>(n));
+    ::close(fd);
+    assert(reply.find("tiletwister_moves_total 3\n") != std::string::npos);
+#endif
+  }
+#ifndef _WIN32
+  assert(::access(socketPath.c_str(), F_OK) != 0); // removed on stop
+#endif
+  std::remove(path.c_str());
+}
+
+// Verifies input-to-photon bookkeeping:
+// - only a frame that shows a polled input closes a measurement, once
+// - repeats (input 0) are ignored; percentiles use the last kWindow samples.
+static void testInputLatency() {
+  InputLatency lat;
+  const bool idle = lat.presented(1000);
+  assert(lat.percentileMs(0.5) == 0.0f && !idle);
+
+  lat.keyPolled(1'000'000);
+  assert(lat.lastPollNs() == 1'000'000);
+  lat.frameShowsInput(0); // key repeat: nothing to measure
+  const bool repeat = lat.presented(2'000'000);
+  assert(!repeat);
+  lat.frameShowsInput(lat.lastPollNs());
+  const bool shown = lat.presented(21'000'000); // 20 ms later
+  assert(shown);
+  const bool again = lat.presented(40'000'000); // later frames don't count
+  assert(!again);
+  assert(lat.count() == 1 && lat.percentileMs(0.99) == 20.0f);
+
+  for (int i = 1; i <= 100; ++i) lat.record(i * 1'000'000LL);
+  assert(lat.percentileMs(0.5) == 50.0f);
+  assert(lat.percentileMs(0.99) == 99.0f);
+  for (int i = 0; i < InputLatency::kWindow; ++i) lat.record(5'000'000);
+  assert(lat.percentileMs(0.99) == 5.0f); // old samples left the window
+  assert(lat.count() == 101 + InputLatency::kWindow);
+}
+
+// Verifies trace export (only meaningful when built with tracing):
+// - zones from several threads land in one Chrome trace file with names
+// - a full ring keeps the most recent events only
+// - without TILETWISTER_ENABLE_TRACING export reports failure.
+static void testTraceExport() {
+  const std::string path = "tiletwister_test_trace.json";
+  std::remove(path.c_str());
+  if (!Trace::kEnabled) {
+    TT_TRACE_SCOPE("ignored");
+    const bool written = Trace::writeChromeTrace(path);
+    assert(!written);
+    return;
+  }
+
+  std::thread worker([] {
+    TT_TRACE_THREAD("test-worker");
+    for (int i = 0; i < 100; ++i) TT_TRACE_SCOPE("worker zone");
+  });
+  worker.join();
+  for (std::uint32_t i = 0; i < Trace::detail::kRingEvents + 10; ++i) {
+    TT_TRACE_SCOPE("main zone");
+  }
+  const bool written = Trace::writeChromeTrace(path);
+  assert(written);
+
+  const std::string json = readFile(path);
+  auto count = [&](const std::string& needle) {
+    std::size_t n = 0;
+    for (std::size_t at = json.find(needle); at != std::string::npos;
+         at = json.find(needle, at + 1))
+      ++n;
+    return n;
+  };
+  assert(count("\"name\":\"worker zone\"") == 100);
+  assert(count("\"name\":\"main zone\"") == Trace::detail::kRingEvents);
+  assert(count("test-worker") == 1);
+  assert(json.find("\"ph\":\"X\"") != std::string::npos);
+  std::remove(path.c_str());
+}
+
 // Integration test for the "engine layer":
 // validates that Scene:
 // - calls update() in insertion order
@@ -217,6 +1348,196 @@ static void testIntegrationSceneLifecycleAndOrdering() {
   assert(rb < ra);
 }
 
+// Verifies the cached Scene render order and batched removal:
+// - pooled objects (spawn) and heap objects (add) render together by z
+// - zIndexChanged() re-sorts; equal z keeps insertion order
+// - dead objects are skipped at once and destroyed in a batch
+static void testSceneReorderAndBatchedRemoval() {
+  struct Counted final : public GameObject {
+    int id;
+    int z;
+    bool isAlive = true;
+    std::vector<int>* rendered;
+    int* destroyed;
+
+    Counted(int i, int zIndex, std::vector<int>* r, int* d)
+        : id(i), z(zIndex), rendered(r), destroyed(d) {}
+    ~Counted() override { ++*destroyed; }
+
+    void update(float) override {}
+    void render(SDL_Renderer*) override { rendered->push_back(id); }
+    int zIndex() const override { return z; }
+    bool alive() const override { return isAlive; }
+  };
+
+  std::vector<int> rendered;
+  int destroyed = 0;
+  {
+    Scene scene;
+    std::vector<Counted*> objs;
+    for (int i = 0; i < 1000; ++i)
+      objs.push_back(scene.spawn<Counted>(i, i % 3, &rendered, &destroyed));
+    scene.add(std::make_unique<Counted>(1000, -1, &rendered, &destroyed));
+    assert(scene.size() == 1001);
+
+    scene.update(0.016f);
+    scene.render(nullptr);
+    assert(rendered.size() == 1001);
+    assert(rendered[0] == 1000);
+    assert(rendered[1] == 0 && rendered[2] == 3); // z 0, insertion order
+
+    // Move object 5 (z 2) to the front.
+    objs[5]->z = -2;
+    objs[5]->zIndexChanged();
+    // Kill fewer than a quarter: skipped, not yet destroyed.
+    for (int i = 10; i < 20; ++i) objs[i]->isAlive = false;
+    rendered.clear();
+    scene.update(0.016f);
+    scene.render(nullptr);
+    assert(rendered.size() == 991);
+    assert(rendered[0] == 5 && rendered[1] == 1000);
+    assert(destroyed == 0);
+    assert(scene.size() == 991);
+
+    // Crossing the threshold compacts everything dead in one pass.
+    for (int i = 100; i < 400; ++i) objs[i]->isAlive = false;
+    scene.update(0.016f);
+    assert(destroyed == 310);
+    assert(scene.size() == 691);
+
+    // Pool blocks are reused.
+    for (int i = 0; i < 300; ++i)
+      scene.spawn<Counted>(2000 + i, 0, &rendered, &destroyed);
+    rendered.clear();
+    scene.render(nullptr);
+    assert(rendered.size() == 991);
+    assert(rendered[0] == 5 && rendered[1] == 1000 && rendered[2] == 0);
+  }
+  assert(destroyed == 1301);
+}
+
+// Verifies the data-oriented engine layer:
+// - ComponentArray stays dense and consistent through swap-removes
+// - TweenSystem writes tween values into Transforms and retires them
+// - EventBus only calls the subscribers of the dispatched type; handlers can
+//   (un)subscribe, themselves included, while it dispatches
+// - Scene renders systems interleaved with GameObjects by z
+static void testWorldSystemsAndEventBus() {
+  ComponentArray<int> arr;
+  for (std::uint32_t e = 0; e < 10; ++e) arr.add(e, static_cast<int>(e) * 10);
+  arr.remove(3);
+  arr.remove(9);
+  arr.remove(42); // not present
+  assert(arr.size() == 8 && !arr.has(3) && arr.has(8));
+  for (std::size_t i = 0; i < arr.size(); ++i)
+    assert(arr.data()[i] == static_cast<int>(arr.entityAt(i)) * 10);
+  arr.sort([](int a, int b) { return a > b; });
+  assert(arr.data()[0] == 80 && arr.get(8) == 80 && arr.get(0) == 0);
+
+  World world;
+  std::vector<Entity> ents;
+  for (int i = 0; i < 2000; ++i) {
+    const Entity e = world.create();
+    world.addTransform(e, Transform{0.0f, 0.0f, 4.0f, 4.0f, 1.0f});
+    world.tweenTo(e, TweenComponent::Target::Position, 10.0f,
+                  static_cast<float>(i), 0.1f, Easing::Linear,
+                  /*destroyOnFinish=*/i % 2 == 1);
+    ents.push_back(e);
+  }
+  TweenSystem tweens;
+  tweens.update(world, 0.05f);
+  const Transform& mid = world.transforms().get(ents[10].index);
+  assert(std::fabs(mid.x - 5.0f) < 1e-4f && std::fabs(mid.y - 5.0f) < 1e-4f);
+  tweens.update(world, 0.06f);
+  assert(world.tweens().size() == 0);
+  assert(world.size() == 1000);
+  assert(world.alive(ents[10]) && !world.alive(ents[11]));
+  assert(world.transforms().get(ents[10].index).x == 10.0f);
+  assert(world.transforms().get(ents[10].index).y == 10.0f);
+  const Entity reused = world.create();
+  assert(reused.index % 2 == 1 && reused.generation == 1);
+  assert(!world.alive(ents[reused.index]) && world.alive(reused));
+
+  struct FakeEvent {
+    int payload;
+  };
+  EventBus<FakeEvent> bus;
+  int keyCalls = 0, mouseCalls = 0;
+  auto sub =
+      bus.subscribe(1, [&](const FakeEvent& e) { keyCalls += e.payload; });
+  bus.subscribe(2, [&](const FakeEvent&) { ++mouseCalls; });
+  const int keyRan = bus.dispatch(1, FakeEvent{5});
+  const int noneRan = bus.dispatch(3, FakeEvent{1});
+  assert(keyRan == 1 && noneRan == 0);
+  assert(keyCalls == 5 && mouseCalls == 0);
+  bus.unsubscribe(sub);
+  const int unsubscribedRan = bus.dispatch(1, FakeEvent{5});
+  assert(unsubscribedRan == 0 && keyCalls == 5);
+
+  // Handlers that subscribe to their own type (many times, forcing the list
+  // to grow) and unsubscribe themselves while running.
+  EventBus<FakeEvent> selfBus;
+  int added = 0, selfCalls = 0;
+  EventBus<FakeEvent>::Subscription self{};
+  self = selfBus.subscribe(7, [&](const FakeEvent&) {
+    ++selfCalls;
+    for (int i = 0; i < 64; ++i)
+      selfBus.subscribe(7, [&](const FakeEvent&) { ++added; });
+    selfBus.unsubscribe(self);
+  });
+  int laterCalls = 0;
+  const auto later =
+      selfBus.subscribe(7, [&](const FakeEvent&) { ++laterCalls; });
+  auto removeLater = selfBus.subscribe(
+      8, [&](const FakeEvent&) { selfBus.unsubscribe(later); });
+  int ran = selfBus.dispatch(7, FakeEvent{0});
+  assert(ran == 2);
+  assert(selfCalls == 1 && laterCalls == 1 && added == 0);
+  ran = selfBus.dispatch(7, FakeEvent{0});
+  assert(ran == 65);
+  assert(selfCalls == 1 && laterCalls == 2 && added == 64);
+  ran = selfBus.dispatch(8, FakeEvent{0});
+  assert(ran == 1);
+  selfBus.unsubscribe(removeLater);
+  ran = selfBus.dispatch(8, FakeEvent{0});
+  assert(ran == 0);
+  ran = selfBus.dispatch(7, FakeEvent{0});
+  assert(ran == 64 && laterCalls == 2);
+
+  struct TraceSystem final : public System {
+    std::vector<std::string>* log;
+    int z;
+    TraceSystem(std::vector<std::string>* l, int zIndex) : log(l), z(zIndex) {}
+    void update(World&, float) override { log->push_back("update:sys"); }
+    void render(World&, SDL_Renderer*) override {
+      log->push_back("render:sys" + std::to_string(z));
+    }
+    int zIndex() const override { return z; }
+  };
+  struct TraceObject final : public GameObject {
+    std::vector<std::string>* log;
+    int z;
+    TraceObject(std::vector<std::string>* l, int zIndex) : log(l), z(zIndex) {}
+    void update(float) override { log->push_back("update:obj"); }
+    void render(SDL_Renderer*) override {
+      log->push_back("render:obj" + std::to_string(z));
+    }
+    int zIndex() const override { return z; }
+  };
+  std::vector<std::string> log;
+  Scene scene;
+  scene.addSystem(std::make_unique<TraceSystem>(&log, 20));
+  scene.addSystem(std::make_unique<TraceSystem>(&log, 0));
+  scene.add(std::make_unique<TraceObject>(&log, 10));
+  scene.add(std::make_unique<TraceObject>(&log, 0));
+  scene.update(0.016f);
+  scene.render(nullptr);
+  const std::vector<std::string> expected = {
+      "update:obj",  "update:obj",  "update:sys",   "update:sys",
+      "render:obj0", "render:sys0", "render:obj10", "render:sys20"};
+  assert(log == expected);
+}
+
 int main() {
   testMoveLeftSimpleMerge();
   testMoveLeftMergeOnceRule();
@@ -224,7 +1545,32 @@ int main() {
   testMoveUpColumnMerge();
   testGameOverDetection();
   testSpawnPendingAndCommit();
+  testMoveWhileSpawnPendingCommitsSpawn();
+  testFormatIntMatchesToString();
+  testTileExponent();
+  testTweenPoolBatchedUpdate();
+  testFixedTimestepAndInterpolation();
+  testTileStoreMoveKeepsIdsAndMerges();
+  testTileStoreFastForward();
+  testAsyncFileWriterCoalescesAndFlushes();
+  testSaveFileRoundTripAndResume();
+  testGameHistoryAppendAndQueries();
+  testSnapshotHandOff();
+  testBitboardMatchesGame();
+  testExpectimaxSearch();
+  testHintService();
+  testMovePolicies();
+  testGameWall();
+  testSessionPool();
+  testSessionProtocol();
+  testTraceExport();
+  testFrameStatsWindow();
+  testSteadyStateIsAllocationFree();
+  testMetricsExport();
+  testInputLatency();
   testIntegrationSceneLifecycleAndOrdering();
+  testSceneReorderAndBatchedRemoval();
+  testWorldSystemsAndEventBus();
   std::cout << "All tests passed.\n";
   return 0;
 }
@@ -0,0 +1,49 @@
+// Prints statistics over the game history log (no SDL).
+//
+// Usage: tiletwister_history [--last N] [PATH]
+//   PATH      history log (default history.bin; index at PATH.idx)
+//   --last N  window for "best of last N" (default 1000)
+
+#include <tiletwister/game/GameHistory.hpp>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+int main(int argc, char** argv) {
+  std::string path = "history.bin";
+  std::uint64_t last = 1000;
+  for (int i = 1; i < argc; ++i) {
+    if (std::strcmp(argv[i], "--last") == 0 && i + 1 < argc) {
+      last = std::strtoull(argv[++i], nullptr, 10);
+    } else {
+      path = argv[i];
+    }
+  }
+
+  GameHistory history;
+  if (!history.open(path)) {
+    std::fprintf(stderr, "cannot open %s\n", path.c_str());
+    return 1;
+  }
+
+  std::printf("games           %llu\n",
+              static_cast<unsigned long long>(history.size()));
+  if (history.size() == 0) return 0;
+
+  std::printf("best of last %-3llu %d\n", static_cast<unsigned long long>(last),
+              history.bestOfLast(last));
+  std::printf("average score   %.1f\n", history.averageScore());
+  std::printf("score p50/p90/p99  %d / %d / %d\n", history.scorePercentile(50),
+              history.scorePercentile(90), history.scorePercentile(99));
+
+  std::printf("max tile histogram\n");
+  const auto hist = history.maxTileHistogram();
+  for (int e = 0; e < kHistoryTileBuckets; ++e) {
+    if (hist[e] == 0) continue;
+    std::printf("  %7d  %llu\n", 1 << e,
+                static_cast<unsigned long long>(hist[e]));
+  }
+  return 0;
+}
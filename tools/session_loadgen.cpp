@@ -0,0 +1,328 @@
+// Load generator for tiletwister_server (Linux).
+//
+// Usage: tiletwister_loadgen [--socket PATH] [--connections N]
+//                            [--sessions N] [--pipeline N] [--seconds S]
+//   --connections N  client threads, one connection each (default 4)
+//   --sessions N     games per connection (default 256)
+//   --pipeline N     requests per round trip, at most one per game
+//                    (default 256)
+//   --seconds S      run time (default 5)
+//
+// Each connection opens its games, then sends batches of random moves over
+// them round-robin; a game that ends is closed and replaced. Every response
+// is checked (status, session, move count). Prints moves/sec and round-trip
+// latency percentiles; exits with 1 on any protocol error.
+
+#include <tiletwister/core/Rng.hpp>
+#include <tiletwister/game/SessionProtocol.hpp>
+
+#include <errno.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using namespace SessionProtocol;
+
+struct Options {
+  std::string socketPath = "/tmp/tiletwister.sock";
+  int connections = 4;
+  int sessions = 256;
+  int pipeline = 256;
+  double seconds = 5.0;
+};
+
+struct Result {
+  std::uint64_t moves = 0;
+  std::uint64_t games = 0; // finished and replaced
+  std::uint64_t errors = 0;
+  std::vector<std::uint32_t> roundTripUs;
+};
+
+int connectTo(const std::string& path) {
+  sockaddr_un addr{};
+  if (path.size() >= sizeof(addr.sun_path)) return -1;
+  const int fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+  if (fd < 0) return -1;
+  addr.sun_family = AF_UNIX;
+  std::memcpy(addr.sun_path, path.c_str(), path.size() + 1);
+  if (::connect(fd, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)) !=
+      0) {
+    ::close(fd);
+    return -1;
+  }
+  return fd;
+}
+
+bool sendAll(int fd, const std::uint8_t* p, std::size_t n) {
+  while (n > 0) {
+    const ssize_t w = ::send(fd, p, n, MSG_NOSIGNAL);
+    if (w < 0 && errno == EINTR) continue;
+    if (w <= 0) return false;
+    p += w;
+    n -= static_cast<std::size_t>(w);
+  }
+  return true;
+}
+
+bool recvAll(int fd, std::uint8_t* p, std::size_t n) {
+  while (n > 0) {
+    const ssize_t r = ::read(fd, p, n);
+    if (r < 0 && errno == EINTR) continue;
+    if (r <= 0) return false;
+    p += r;
+    n -= static_cast<std::size_t>(r);
+  }
+  return true;
+}
+
+// Unanswered requests per connection: 192 KB of responses, well below the
+// server's per-client limit.
+constexpr std::size_t kMaxInFlight = 8192;
+
+class Client {
+public:
+  Client(int fd, const Options& opt, std::uint64_t seed)
+      : m_fd(fd), m_opt(opt), m_rng(seed),
+        m_ids(static_cast<std::size_t>(opt.sessions), 0),
+        m_moves(static_cast<std::size_t>(opt.sessions), 0),
+        m_over(static_cast<std::size_t>(opt.sessions), false),
+        m_req(static_cast<std::size_t>(opt.pipeline) * kRequestSize),
+        m_resp(static_cast<std::size_t>(opt.pipeline) * kResponseSize),
+        m_slots(static_cast<std::size_t>(opt.pipeline), 0) {}
+
+  // Sends one batch and checks its answers. False on I/O failure.
+  bool roundTrip(Result& out) {
+    const int batch = m_opt.pipeline;
+    for (int i = 0; i < batch; ++i) {
+      const int slot = m_next;
+      m_next = (m_next + 1) % m_opt.sessions;
+      m_slots[i] = slot;
+      Request req;
+      if (m_ids[slot] == 0) {
+        req.op = Op::NewGame;
+      } else if (m_over[slot]) {
+        req.op = Op::Close;
+        req.session = m_ids[slot];
+      } else {
+        req.op = Op::Move;
+        req.dir = static_cast<Direction>(m_rng.below(4));
+        req.session = m_ids[slot];
+      }
+      encodeRequest(req, m_req.data() + i * kRequestSize);
+    }
+
+    const auto t0 = std::chrono::steady_clock::now();
+    if (!exchange(static_cast<std::size_t>(batch))) return false;
+    const auto t1 = std::chrono::steady_clock::now();
+    out.roundTripUs.push_back(static_cast<std::uint32_t>(
+        std::chrono::duration_cast<std::chrono::microseconds>(t1 - t0)
+            .count()));
+
+    for (int i = 0; i < batch; ++i) check(i, out);
+    return true;
+  }
+
+  // Closes the games still open (answers are read back and checked).
+  bool finish(Result& out) {
+    std::size_t count = 0;
+    for (int slot = 0; slot < m_opt.sessions; ++slot) {
+      if (m_ids[slot] == 0) continue;
+      Request req;
+      req.op = Op::Close;
+      req.session = m_ids[slot];
+      if (count == m_slots.size()) {
+        m_req.resize(m_req.size() * 2);
+        m_resp.resize(m_resp.size() * 2);
+        m_slots.resize(m_slots.size() * 2);
+      }
+      encodeRequest(req, m_req.data() + count * kRequestSize);
+      ++count;
+    }
+    if (!exchange(count)) return false;
+    for (std::size_t i = 0; i < count; ++i) {
+      Response resp;
+      decodeResponse(m_resp.data() + i * kResponseSize, resp);
+      if (resp.status != Status::Ok || resp.op != Op::Close) ++out.errors;
+    }
+    return true;
+  }
+
+private:
+  int m_fd;
+  const Options& m_opt;
+  Rng m_rng;
+  std::vector<std::uint32_t> m_ids;   // 0: no game yet
+  std::vector<std::uint32_t> m_moves; // move count last seen
+  std::vector<bool> m_over;           // ended; closed on its next turn
+  std::vector<std::uint8_t> m_req;
+  std::vector<std::uint8_t> m_resp;
+  std::vector<int> m_slots; // slot of each request in the batch
+  int m_next = 0;
+
+  // Sends the first count requests of m_req and reads their responses into
+  // m_resp, keeping at most kMaxInFlight unanswered: the server stops
+  // reading from a client that leaves too many responses unread, so sending
+  // a large batch in one go would deadlock.
+  bool exchange(std::size_t count) {
+    std::size_t sent = 0;
+    std::size_t received = 0;
+    while (received < count) {
+      const std::size_t n =
+          std::min(count - sent, kMaxInFlight - (sent - received));
+      if (n > 0 && !sendAll(m_fd, m_req.data() + sent * kRequestSize,
+                            n * kRequestSize))
+        return false;
+      sent += n;
+      const std::size_t m = std::min(sent - received, kMaxInFlight / 2);
+      if (!recvAll(m_fd, m_resp.data() + received * kResponseSize,
+                   m * kResponseSize))
+        return false;
+      received += m;
+    }
+    return true;
+  }
+
+  void check(int i, Result& out) {
+    Response resp;
+    decodeResponse(m_resp.data() + i * kResponseSize, resp);
+    const int slot = m_slots[i];
+    if (resp.status != Status::Ok) {
+      ++out.errors;
+      return;
+    }
+    switch (resp.op) {
+    case Op::NewGame:
+      m_ids[slot] = resp.session;
+      m_moves[slot] = 0;
+      m_over[slot] = false;
+      if (resp.moves != 0 || Bitboards::countEmpty(resp.board) != 14)
+        ++out.errors;
+      break;
+    case Op::Move: {
+      const bool moved = resp.flags & kFlagMoved;
+      if (resp.session != m_ids[slot] ||
+          resp.moves != m_moves[slot] + (moved ? 1 : 0))
+        ++out.errors;
+      m_moves[slot] = resp.moves;
+      if (moved) ++out.moves;
+      if (resp.flags & kFlagGameOver) m_over[slot] = true;
+      break;
+    }
+    case Op::Close:
+      m_ids[slot] = 0;
+      ++out.games;
+      break;
+    default:
+      ++out.errors;
+    }
+  }
+};
+
+void runClient(const Options& opt, int index, Result& out,
+               const std::atomic<bool>& stop) {
+  const int fd = connectTo(opt.socketPath);
+  if (fd < 0) {
+    std::fprintf(stderr, "cannot connect to %s: %s\n", opt.socketPath.c_str(),
+                 std::strerror(errno));
+    ++out.errors;
+    return;
+  }
+  Client client(fd, opt, 0x2048u + static_cast<std::uint64_t>(index));
+  while (!stop.load(std::memory_order_relaxed)) {
+    if (!client.roundTrip(out)) {
+      std::fprintf(stderr, "connection %d lost\n", index);
+      ++out.errors;
+      break;
+    }
+  }
+  client.finish(out);
+  ::close(fd);
+}
+
+std::uint32_t percentile(std::vector<std::uint32_t>& v, double q) {
+  if (v.empty()) return 0;
+  const auto n = static_cast<double>(v.size());
+  const std::size_t k =
+      std::min(v.size() - 1, static_cast<std::size_t>(q * n));
+  std::nth_element(v.begin(), v.begin() + static_cast<std::ptrdiff_t>(k),
+                   v.end());
+  return v[k];
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  Options opt;
+  for (int i = 1; i < argc; ++i) {
+    const bool hasValue = i + 1 < argc;
+    if (std::strcmp(argv[i], "--socket") == 0 && hasValue) {
+      opt.socketPath = argv[++i];
+    } else if (std::strcmp(argv[i], "--connections") == 0 && hasValue) {
+      opt.connections = std::max(1, std::atoi(argv[++i]));
+    } else if (std::strcmp(argv[i], "--sessions") == 0 && hasValue) {
+      opt.sessions = std::max(1, std::atoi(argv[++i]));
+    } else if (std::strcmp(argv[i], "--pipeline") == 0 && hasValue) {
+      opt.pipeline = std::max(1, std::atoi(argv[++i]));
+    } else if (std::strcmp(argv[i], "--seconds") == 0 && hasValue) {
+      opt.seconds = std::atof(argv[++i]);
+    } else {
+      std::fprintf(stderr,
+                   "usage: %s [--socket PATH] [--connections N] "
+                   "[--sessions N] [--pipeline N] [--seconds S]\n",
+                   argv[0]);
+      return 1;
+    }
+  }
+  // Every request of a batch goes to a different game, so a batch never
+  // opens or closes the same slot twice.
+  opt.pipeline = std::min(opt.pipeline, opt.sessions);
+
+  std::vector<Result> results(static_cast<std::size_t>(opt.connections));
+  std::atomic<bool> stop{false};
+  std::vector<std::thread> threads;
+  const auto t0 = std::chrono::steady_clock::now();
+  for (int i = 0; i < opt.connections; ++i)
+    threads.emplace_back([&, i] { runClient(opt, i, results[i], stop); });
+  std::this_thread::sleep_for(std::chrono::duration<double>(opt.seconds));
+  stop.store(true);
+  for (std::thread& t : threads) t.join();
+  const double sec =
+      std::chrono::duration<double>(std::chrono::steady_clock::now() - t0)
+          .count();
+
+  Result total;
+  for (Result& r : results) {
+    total.moves += r.moves;
+    total.games += r.games;
+    total.errors += r.errors;
+    total.roundTripUs.insert(total.roundTripUs.end(), r.roundTripUs.begin(),
+                             r.roundTripUs.end());
+  }
+  std::printf("connections %d  sessions %d  pipeline %d  %.1f s\n",
+              opt.connections, opt.connections * opt.sessions, opt.pipeline,
+              sec);
+  std::printf("moves         %llu (%.0f/s)\n",
+              static_cast<unsigned long long>(total.moves),
+              static_cast<double>(total.moves) / sec);
+  std::printf("games ended   %llu\n",
+              static_cast<unsigned long long>(total.games));
+  const std::uint32_t p50 = percentile(total.roundTripUs, 0.5);
+  const std::uint32_t p99 = percentile(total.roundTripUs, 0.99);
+  std::printf("round trip    p50 %u us  p99 %u us (%d requests)\n", p50, p99,
+              opt.pipeline);
+  std::printf("errors        %llu\n",
+              static_cast<unsigned long long>(total.errors));
+  return total.errors == 0 ? 0 : 1;
+}
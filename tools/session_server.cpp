@@ -0,0 +1,319 @@
+// Headless game-session server: many concurrent players against one process
+// over a Unix domain socket (Linux; epoll). No SDL.
+//
+// Usage: tiletwister_server [--socket PATH] [--max-sessions N] [--stats]
+//                           [--stats-file PATH] [--stats-socket PATH]
+//                           [--stats-interval MS]
+//   --socket PATH       listening socket (default /tmp/tiletwister.sock)
+//   --max-sessions N    session pool size (default 1048576)
+//   --stats             print sessions, connections and moves/sec every second
+//   --stats-*           export metrics, as in the game (see README)
+//
+// The protocol is in SessionProtocol.hpp. One thread serves every
+// connection: each readable socket is drained, every complete request in the
+// buffer is answered in one pass over the session pool, and the responses go
+// out in a single write. Clients are expected to pipeline.
+
+#include <tiletwister/core/Metrics.hpp>
+#include <tiletwister/core/MetricsExporter.hpp>
+#include <tiletwister/game/SessionPool.hpp>
+#include <tiletwister/game/SessionProtocol.hpp>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+
+// Per-connection buffers: reads stop while this many response bytes are
+// still unsent (slow reader), so memory stays bounded per client.
+constexpr std::size_t kReadBuffer = 64 * 1024;
+constexpr std::size_t kMaxPendingOut = 1024 * 1024;
+constexpr int kMaxEvents = 256;
+
+volatile sig_atomic_t g_stop = 0;
+
+void onSignal(int) { g_stop = 1; }
+
+struct Connection {
+  bool open = false;
+  std::uint32_t owner = 0; // SessionPool owner tag, unique per accept
+  std::vector<std::uint8_t> in;
+  std::size_t inLen = 0;
+  std::vector<std::uint8_t> out;
+  std::size_t outPos = 0;
+  std::uint32_t events = 0; // registered with epoll
+  std::vector<std::uint32_t> sessions; // to close on disconnect
+};
+
+struct Server {
+  SessionPool pool;
+  int epfd = -1;
+  int listenFd = -1;
+  std::vector<Connection> conns; // indexed by fd
+  std::uint32_t nextOwner = 1;
+  int connections = 0;
+
+  explicit Server(std::uint32_t maxSessions)
+      : pool(maxSessions, static_cast<std::uint64_t>(
+                              std::chrono::steady_clock::now()
+                                  .time_since_epoch()
+                                  .count())) {}
+
+  void accept() {
+    for (;;) {
+      const int fd = ::accept4(listenFd, nullptr, nullptr,
+                               SOCK_NONBLOCK | SOCK_CLOEXEC);
+      if (fd < 0) return; // EAGAIN, or a client that already gave up
+      if (static_cast<std::size_t>(fd) >= conns.size())
+        conns.resize(static_cast<std::size_t>(fd) + 1);
+      Connection& c = conns[fd];
+      c.open = true;
+      c.owner = nextOwner++;
+      c.in.resize(kReadBuffer);
+      c.inLen = 0;
+      c.out.clear();
+      c.outPos = 0;
+      c.events = EPOLLIN;
+      c.sessions.clear();
+      epoll_event ev{};
+      ev.events = c.events;
+      ev.data.fd = fd;
+      epoll_ctl(epfd, EPOLL_CTL_ADD, fd, &ev);
+      ++connections;
+    }
+  }
+
+  void close(int fd) {
+    Connection& c = conns[fd];
+    for (std::uint32_t id : c.sessions) pool.destroy(id);
+    c.sessions.clear();
+    c.open = false;
+    epoll_ctl(epfd, EPOLL_CTL_DEL, fd, nullptr);
+    ::close(fd);
+    --connections;
+  }
+
+  // Answers every complete request in the read buffer.
+  void process(Connection& c) {
+    using namespace SessionProtocol;
+    const std::size_t count = c.inLen / kRequestSize;
+    if (count == 0) return;
+    const std::size_t base = c.out.size();
+    c.out.resize(base + count * kResponseSize);
+    std::uint64_t moves = 0;
+    std::uint64_t games = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+      const Response resp =
+          handleRequest(pool, c.owner, c.in.data() + i * kRequestSize,
+                        c.out.data() + base + i * kResponseSize);
+      if (resp.status != Status::Ok) continue;
+      if (resp.op == Op::NewGame) {
+        c.sessions.push_back(resp.session);
+      } else if (resp.op == Op::Close) {
+        auto it =
+            std::find(c.sessions.begin(), c.sessions.end(), resp.session);
+        if (it != c.sessions.end()) {
+          *it = c.sessions.back();
+          c.sessions.pop_back();
+        }
+      } else if (resp.flags & kFlagMoved) {
+        ++moves;
+        if (resp.flags & kFlagGameOver) ++games;
+      }
+    }
+    const std::size_t used = count * kRequestSize;
+    std::memmove(c.in.data(), c.in.data() + used, c.inLen - used);
+    c.inLen -= used;
+    if (moves) metrics().moves.add(moves);
+    if (games) metrics().games.add(games);
+  }
+
+  // False if the connection failed.
+  bool flush(int fd, Connection& c) {
+    while (c.outPos < c.out.size()) {
+      const ssize_t n = ::send(fd, c.out.data() + c.outPos,
+                               c.out.size() - c.outPos, MSG_NOSIGNAL);
+      if (n > 0) {
+        c.outPos += static_cast<std::size_t>(n);
+        continue;
+      }
+      if (n < 0 && errno == EINTR) continue;
+      if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) break;
+      return false;
+    }
+    if (c.outPos == c.out.size()) {
+      c.out.clear();
+      c.outPos = 0;
+    }
+    // Poll for writability only while output is queued, and stop reading
+    // from a client that doesn't read its answers.
+    const std::size_t pending = c.out.size() - c.outPos;
+    std::uint32_t events = 0;
+    if (pending < kMaxPendingOut) events |= EPOLLIN;
+    if (pending > 0) events |= EPOLLOUT;
+    if (events != c.events) {
+      c.events = events;
+      epoll_event ev{};
+      ev.events = events;
+      ev.data.fd = fd;
+      epoll_ctl(epfd, EPOLL_CTL_MOD, fd, &ev);
+    }
+    return true;
+  }
+
+  // False if the peer closed or the connection failed.
+  bool read(int fd, Connection& c) {
+    while (c.out.size() - c.outPos < kMaxPendingOut) {
+      const ssize_t n =
+          ::read(fd, c.in.data() + c.inLen, c.in.size() - c.inLen);
+      if (n > 0) {
+        c.inLen += static_cast<std::size_t>(n);
+        process(c);
+        continue;
+      }
+      if (n == 0) return false;
+      if (errno == EINTR) continue;
+      return errno == EAGAIN || errno == EWOULDBLOCK;
+    }
+    return true;
+  }
+
+  void handle(const epoll_event& ev) {
+    const int fd = ev.data.fd;
+    if (fd == listenFd) {
+      accept();
+      return;
+    }
+    Connection& c = conns[fd];
+    if (!c.open) return;
+    bool ok = !(ev.events & EPOLLERR);
+    if (ok && (ev.events & (EPOLLIN | EPOLLHUP))) ok = read(fd, c);
+    // Write even after the peer shut down its side: answers may still fit.
+    const bool flushed = flush(fd, c);
+    if (!ok || !flushed) close(fd);
+  }
+};
+
+int listenOn(const std::string& path) {
+  sockaddr_un addr{};
+  if (path.size() >= sizeof(addr.sun_path)) return -1;
+  const int fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC,
+                          0);
+  if (fd < 0) return -1;
+  addr.sun_family = AF_UNIX;
+  std::memcpy(addr.sun_path, path.c_str(), path.size() + 1);
+  ::unlink(path.c_str());
+  if (::bind(fd, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)) !=
+          0 ||
+      ::listen(fd, SOMAXCONN) != 0) {
+    ::close(fd);
+    return -1;
+  }
+  return fd;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  std::string socketPath = "/tmp/tiletwister.sock";
+  std::uint32_t maxSessions = 1u << 20;
+  bool printStats = false;
+  std::string statsFile;
+  std::string statsSocket;
+  int statsIntervalMs = 1000;
+  for (int i = 1; i < argc; ++i) {
+    const bool hasValue = i + 1 < argc;
+    if (std::strcmp(argv[i], "--socket") == 0 && hasValue) {
+      socketPath = argv[++i];
+    } else if (std::strcmp(argv[i], "--max-sessions") == 0 && hasValue) {
+      maxSessions = static_cast<std::uint32_t>(std::atoi(argv[++i]));
+    } else if (std::strcmp(argv[i], "--stats") == 0) {
+      printStats = true;
+    } else if (std::strcmp(argv[i], "--stats-file") == 0 && hasValue) {
+      statsFile = argv[++i];
+    } else if (std::strcmp(argv[i], "--stats-socket") == 0 && hasValue) {
+      statsSocket = argv[++i];
+    } else if (std::strcmp(argv[i], "--stats-interval") == 0 && hasValue) {
+      statsIntervalMs = std::atoi(argv[++i]);
+    } else {
+      std::fprintf(stderr,
+                   "usage: %s [--socket PATH] [--max-sessions N] [--stats] "
+                   "[--stats-file PATH] [--stats-socket PATH] "
+                   "[--stats-interval MS]\n",
+                   argv[0]);
+      return 1;
+    }
+  }
+
+  Server server(maxSessions);
+  server.listenFd = listenOn(socketPath);
+  if (server.listenFd < 0) {
+    std::fprintf(stderr, "cannot listen on %s: %s\n", socketPath.c_str(),
+                 std::strerror(errno));
+    return 1;
+  }
+  server.epfd = ::epoll_create1(EPOLL_CLOEXEC);
+  epoll_event lev{};
+  lev.events = EPOLLIN;
+  lev.data.fd = server.listenFd;
+  epoll_ctl(server.epfd, EPOLL_CTL_ADD, server.listenFd, &lev);
+
+  // No SA_RESTART: epoll_wait returns EINTR and the loop sees g_stop.
+  struct sigaction sa {};
+  sa.sa_handler = onSignal;
+  sigaction(SIGINT, &sa, nullptr);
+  sigaction(SIGTERM, &sa, nullptr);
+
+  MetricsExporter exporter(metrics(), statsFile, statsSocket, statsIntervalMs);
+  if ((!statsFile.empty() || !statsSocket.empty()) && !exporter.start()) {
+    std::fprintf(stderr, "metrics export disabled: can't listen on %s\n",
+                 statsSocket.c_str());
+  }
+  std::fprintf(stderr, "listening on %s (%u sessions)\n", socketPath.c_str(),
+               server.pool.capacity());
+
+  using Clock = std::chrono::steady_clock;
+  auto lastReport = Clock::now();
+  std::uint64_t lastMoves = metrics().moves.value();
+  epoll_event events[kMaxEvents];
+  while (!g_stop) {
+    const int n = ::epoll_wait(server.epfd, events, kMaxEvents, 1000);
+    for (int i = 0; i < n; ++i) server.handle(events[i]);
+
+    const auto now = Clock::now();
+    if (printStats && now - lastReport >= std::chrono::seconds(1)) {
+      const std::uint64_t moves = metrics().moves.value();
+      const double sec =
+          std::chrono::duration<double>(now - lastReport).count();
+      std::fprintf(stderr, "connections %d  sessions %u  moves/s %.0f\n",
+                   server.connections, server.pool.live(),
+                   static_cast<double>(moves - lastMoves) / sec);
+      lastReport = now;
+      lastMoves = moves;
+    }
+  }
+
+  for (std::size_t fd = 0; fd < server.conns.size(); ++fd)
+    if (server.conns[fd].open) server.close(static_cast<int>(fd));
+  ::close(server.epfd);
+  ::close(server.listenFd);
+  ::unlink(socketPath.c_str());
+  exporter.stop();
+  std::fprintf(stderr, "moves %llu  games finished %llu\n",
+               static_cast<unsigned long long>(metrics().moves.value()),
+               static_cast<unsigned long long>(metrics().games.value()));
+  return 0;
+}